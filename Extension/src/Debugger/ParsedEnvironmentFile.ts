@@ -14,7 +14,136 @@ export interface Environment {
     value: string;
 }
 
+/**
+ * Parses the lines of an envFile in a single pass. Content can be written in chunks as it is read;
+ * lines that span chunks are completed by the next chunk.
+ */
+class EnvironmentFileTokenizer {
+    public readonly env: Environment[] = [];
+    public readonly parseErrors: string[] = [];
+    // The index of each variable in env, so that later definitions replace earlier ones in place.
+    private indices: Map<string, number> = new Map<string, number>();
+    private pending: string = "";
+    private isFirstChunk: boolean = true;
+
+    public write(chunk: string): void {
+        // Remove UTF-8 BOM if present
+        if (this.isFirstChunk && chunk.charAt(0) === '\uFEFF') {
+            chunk = chunk.substr(1);
+        }
+        this.isFirstChunk = false;
+        const content: string = this.pending + chunk;
+        let lineStart: number = 0;
+        let lineEnd: number = content.indexOf("\n");
+        while (lineEnd >= 0) {
+            this.parseLine(content, lineStart, lineEnd);
+            lineStart = lineEnd + 1;
+            lineEnd = content.indexOf("\n", lineStart);
+        }
+        this.pending = content.substr(lineStart);
+    }
+
+    public end(): void {
+        this.parseLine(this.pending, 0, this.pending.length);
+        this.pending = "";
+    }
+
+    public set(name: string, value: string): void {
+        const index: number | undefined = this.indices.get(name);
+        if (index === undefined) {
+            this.indices.set(name, this.env.length);
+            this.env.push({ name: name, value: value });
+        } else {
+            this.env[index].value = value;
+        }
+    }
+
+    // Equivalent to matching the line with /^\s*([\w\.\-]+)\s*=\s*(.*)?\s*$/, where lines that are blank or
+    // start with # are not parse errors.
+    private parseLine(content: string, start: number, end: number): void {
+        let i: number = EnvironmentFileTokenizer.skipWhitespace(content, start, end);
+        const keyStart: number = i;
+        while (i < end && EnvironmentFileTokenizer.isKeyCharacter(content.charCodeAt(i))) {
+            ++i;
+        }
+        const keyEnd: number = i;
+        i = EnvironmentFileTokenizer.skipWhitespace(content, i, end);
+        if (keyEnd === keyStart || i === end || content.charAt(i) !== '=') {
+            // Blank lines and lines starting with # are no parse errors
+            if (keyEnd !== keyStart || (i !== end && content.charAt(i) !== '#')) {
+                this.parseErrors.push(content.substring(start, end));
+            }
+            return;
+        }
+        const valueStart: number = EnvironmentFileTokenizer.skipWhitespace(content, i + 1, end);
+        // The value ends at the first line terminator other than \n, which may only be followed by whitespace.
+        let valueEnd: number = valueStart;
+        while (valueEnd < end && !EnvironmentFileTokenizer.isLineTerminator(content.charCodeAt(valueEnd))) {
+            ++valueEnd;
+        }
+        if (EnvironmentFileTokenizer.skipWhitespace(content, valueEnd, end) !== end) {
+            this.parseErrors.push(content.substring(start, end));
+            return;
+        }
+
+        // Remove one leading and one trailing quote.
+        let quoteStart: number = valueStart;
+        let quoteEnd: number = valueEnd;
+        if (quoteStart < quoteEnd && EnvironmentFileTokenizer.isQuote(content.charCodeAt(quoteStart))) {
+            ++quoteStart;
+        }
+        if (quoteStart < quoteEnd && EnvironmentFileTokenizer.isQuote(content.charCodeAt(quoteEnd - 1))) {
+            --quoteEnd;
+        }
+        let value: string = content.substring(quoteStart, quoteEnd);
+        if (valueEnd - valueStart > 0 && content.charAt(valueStart) === '"' && content.charAt(valueEnd - 1) === '"' && value.indexOf("\\n") >= 0) {
+            value = value.replace(/\\n/gm, "\n");
+        }
+
+        this.set(content.substring(keyStart, keyEnd), value);
+    }
+
+    private static skipWhitespace(content: string, i: number, end: number): number {
+        while (i < end && EnvironmentFileTokenizer.isWhitespace(content.charCodeAt(i))) {
+            ++i;
+        }
+        return i;
+    }
+
+    // ' or "
+    private static isQuote(c: number): boolean {
+        return c === 0x22 || c === 0x27;
+    }
+
+    // [A-Za-z0-9_.-]
+    private static isKeyCharacter(c: number): boolean {
+        return (c >= 0x61 && c <= 0x7A) || (c >= 0x41 && c <= 0x5A) || (c >= 0x30 && c <= 0x39) || c === 0x5F || c === 0x2E || c === 0x2D;
+    }
+
+    // The characters that . does not match in a regular expression (other than \n, which ends the line).
+    private static isLineTerminator(c: number): boolean {
+        return c === 0x0D || c === 0x2028 || c === 0x2029;
+    }
+
+    // The characters matched by \s in a regular expression.
+    private static isWhitespace(c: number): boolean {
+        return c === 0x20 || (c >= 0x09 && c <= 0x0D) || c === 0xA0 || c === 0x1680 || (c >= 0x2000 && c <= 0x200A) ||
+            c === 0x2028 || c === 0x2029 || c === 0x202F || c === 0x205F || c === 0x3000 || c === 0xFEFF;
+    }
+}
+
+interface CachedEnvironmentFile {
+    mtimeMs: number;
+    size: number;
+    env: Environment[];
+    parseErrors: string[];
+}
+
 export class ParsedEnvironmentFile {
+    // Parsed envFiles, keyed by path. An entry is used while the file's modification time and size are unchanged.
+    private static cache: Map<string, CachedEnvironmentFile> = new Map<string, CachedEnvironmentFile>();
+    private static readonly maxCacheSize: number = 50;
+
     public Env: Environment[];
     public Warning?: string;
 
@@ -28,62 +157,53 @@ export class ParsedEnvironmentFile {
         return this.CreateFromContent(content, envFile, initialEnv);
     }
 
-    public static CreateFromContent(content: string, envFile: string, initialEnv?: Environment[]): ParsedEnvironmentFile {
-
-        // Remove UTF-8 BOM if present
-        if (content.charAt(0) === '\uFEFF') {
-            content = content.substr(1);
+    /**
+     * Reads the file as a stream, without blocking. The result is cached until the file changes.
+     */
+    public static async CreateFromFileAsync(envFile: string, initialEnv?: Environment[]): Promise<ParsedEnvironmentFile> {
+        const stats: fs.Stats = await fs.promises.stat(envFile);
+        let cached: CachedEnvironmentFile | undefined = ParsedEnvironmentFile.cache.get(envFile);
+        if (!cached || cached.mtimeMs !== stats.mtimeMs || cached.size !== stats.size) {
+            const tokenizer: EnvironmentFileTokenizer = new EnvironmentFileTokenizer();
+            await new Promise<void>((resolve, reject) => {
+                fs.createReadStream(envFile, { encoding: "utf8" })
+                    .on("data", (chunk: string | Buffer) => tokenizer.write(chunk.toString()))
+                    .on("end", () => resolve())
+                    .on("error", (error: Error) => reject(error));
+            });
+            tokenizer.end();
+            cached = { mtimeMs: stats.mtimeMs, size: stats.size, env: tokenizer.env, parseErrors: tokenizer.parseErrors };
+            if (ParsedEnvironmentFile.cache.size >= ParsedEnvironmentFile.maxCacheSize) {
+                ParsedEnvironmentFile.cache.clear();
+            }
+            ParsedEnvironmentFile.cache.set(envFile, cached);
         }
+        return ParsedEnvironmentFile.Create(cached.env, cached.parseErrors, envFile, initialEnv);
+    }
 
-        const parseErrors: string[] = [];
-        const env: Map<string, any> = new Map();
+    public static CreateFromContent(content: string, envFile: string, initialEnv?: Environment[]): ParsedEnvironmentFile {
+        const tokenizer: EnvironmentFileTokenizer = new EnvironmentFileTokenizer();
+        tokenizer.write(content);
+        tokenizer.end();
+        return ParsedEnvironmentFile.Create(tokenizer.env, tokenizer.parseErrors, envFile, initialEnv);
+    }
 
+    private static Create(fileEnv: Environment[], parseErrors: string[], envFile: string, initialEnv?: Environment[]): ParsedEnvironmentFile {
+        // Variables from the file replace variables with the same name in initialEnv.
+        // The entries are copied, since the file's entries may be cached.
+        const merged: EnvironmentFileTokenizer = new EnvironmentFileTokenizer();
         if (initialEnv) {
-            // Convert array to map to prevent duplicate keys being created.
-            // If a duplicate key is found, replace it.
-            initialEnv.forEach((e) => {
-                env.set(e.name, e.value);
-            });
+            initialEnv.forEach(e => merged.set(e.name, e.value));
         }
-
-        content.split("\n").forEach(line => {
-            // Split the line between key and value
-            const r: RegExpMatchArray | null = line.match(/^\s*([\w\.\-]+)\s*=\s*(.*)?\s*$/);
-
-            if (r) {
-                const key: string = r[1];
-                let value: string = r[2] ?? "";
-                if ((value.length > 0) && (value.charAt(0) === '"') && (value.charAt(value.length - 1) === '"')) {
-                    value = value.replace(/\\n/gm, "\n");
-                }
-
-                value = value.replace(/(^['"]|['"]$)/g, "");
-
-                env.set(key, value);
-            } else {
-                // Blank lines and lines starting with # are no parse errors
-                const comments: RegExp = new RegExp(/^\s*(#|$)/);
-                if (!comments.test(line)) {
-                    parseErrors.push(line);
-                }
-            }
-        });
+        fileEnv.forEach(e => merged.set(e.name, e.value));
 
         // show error message if single lines cannot get parsed
         let warning: string | undefined;
         if (parseErrors.length !== 0) {
-            warning = localize("ignoring.lines.in.envfile", "Ignoring non-parseable lines in {0} {1}: ", "envFile", envFile);
-            parseErrors.forEach(function (value, idx, array): void {
-                warning += "\"" + value + "\"" + ((idx !== array.length - 1) ? ", " : ".");
-            });
-        }
-
-        // Convert env map back to array.
-        const arrayEnv: Environment[] = [];
-        for (const key of env.keys()) {
-            arrayEnv.push({name: key, value: env.get(key)});
+            warning = localize("ignoring.lines.in.envfile", "Ignoring non-parseable lines in {0} {1}: ", "envFile", envFile) +
+                parseErrors.map(value => "\"" + value + "\"").join(", ") + ".";
         }
 
-        return new ParsedEnvironmentFile(arrayEnv, warning);
+        return new ParsedEnvironmentFile(merged.env, warning);
     }
 }
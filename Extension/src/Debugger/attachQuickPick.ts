@@ -31,8 +31,9 @@ export interface AttachItem extends vscode.QuickPickItem {
 }
 
 // We should not await on this function.
-export async function showQuickPick(getAttachItems: () => Promise<AttachItem[]>): Promise<string | undefined> {
-    const processEntries: AttachItem[] = await getAttachItems();
+// The QuickPick is shown right away and filled in as getAttachItems reports partial results.
+// If liveRefreshInterval is set, the list is refreshed in the background while the QuickPick is open.
+export async function showQuickPick(getAttachItems: (onPartialResult?: (items: AttachItem[]) => void) => Promise<AttachItem[]>, liveRefreshInterval?: number): Promise<string | undefined> {
     return new Promise<string | undefined>((resolve, reject) => {
         const quickPick: vscode.QuickPick<AttachItem> = vscode.window.createQuickPick<AttachItem>();
         quickPick.title = localize("attach.to.process", "Attach to process");
@@ -41,10 +42,67 @@ export async function showQuickPick(getAttachItems: () => Promise<AttachItem[]>)
         quickPick.matchOnDetail = true;
         quickPick.placeholder = localize("select.process.attach", "Select the process to attach to");
         quickPick.buttons = [new RefreshButton()];
-        quickPick.items = processEntries;
         const disposables: vscode.Disposable[] = [];
+        let disposed: boolean = false;
+        let liveRefreshTimer: NodeJS.Timer | undefined;
+        const dispose = () => {
+            disposed = true;
+            if (liveRefreshTimer) {
+                global.clearTimeout(liveRefreshTimer);
+            }
+            disposables.forEach(item => item.dispose());
+            quickPick.dispose();
+        };
+
+        let shownItems: AttachItem[] | undefined;
+        const setItems = (items: AttachItem[]) => {
+            // Providers return the same array when nothing changed. Otherwise, keep the active item
+            // (providers reuse the items of unchanged processes) so a refresh doesn't move the selection.
+            if (items !== shownItems) {
+                const activeItems: ReadonlyArray<AttachItem> = quickPick.activeItems;
+                shownItems = items;
+                quickPick.items = items;
+                if (activeItems.length > 0 && items.indexOf(activeItems[0]) >= 0) {
+                    quickPick.activeItems = activeItems;
+                }
+            }
+        };
+
+        // Each refresh replaces the results of any earlier one that is still running.
+        let refreshId: number = 0;
+        const refresh = async (background: boolean = false): Promise<void> => {
+            const id: number = ++refreshId;
+            const isCurrent = () => !disposed && id === refreshId;
+            if (liveRefreshTimer) {
+                global.clearTimeout(liveRefreshTimer);
+                liveRefreshTimer = undefined;
+            }
+            if (!background) {
+                quickPick.busy = true;
+            }
+            try {
+                // Background refreshes only show the complete list.
+                const items: AttachItem[] = await getAttachItems(background ? undefined : partialItems => {
+                    if (isCurrent()) {
+                        setItems(partialItems);
+                    }
+                });
+                if (isCurrent()) {
+                    setItems(items);
+                    quickPick.busy = false;
+                    if (liveRefreshInterval) {
+                        liveRefreshTimer = global.setTimeout(() => refresh(true), liveRefreshInterval);
+                    }
+                }
+            } catch (err) {
+                if (isCurrent()) {
+                    dispose();
+                    reject(err);
+                }
+            }
+        };
 
-        quickPick.onDidTriggerButton(async () => { quickPick.items = await getAttachItems(); }, undefined, disposables);
+        quickPick.onDidTriggerButton(() => refresh(), undefined, disposables);
 
         quickPick.onDidAccept(() => {
             if (quickPick.selectedItems.length !== 1) {
@@ -53,19 +111,18 @@ export async function showQuickPick(getAttachItems: () => Promise<AttachItem[]>)
 
             const selectedId: string | undefined = quickPick.selectedItems[0].id;
 
-            disposables.forEach(item => item.dispose());
-            quickPick.dispose();
+            dispose();
 
             resolve(selectedId);
         }, undefined, disposables);
 
         quickPick.onDidHide(() => {
-            disposables.forEach(item => item.dispose());
-            quickPick.dispose();
+            dispose();
 
             reject(new Error(localize("process.not.selected", "Process not selected.")));
         }, undefined, disposables);
 
         quickPick.show();
+        refresh();
     });
 }
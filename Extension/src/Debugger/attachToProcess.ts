@@ -3,7 +3,8 @@
  * See 'LICENSE' in the project root for license information.
  * ------------------------------------------------------------------------------------------ */
 
-import { PsProcessParser } from './nativeAttach';
+import { Process, PsProcessParser, sortProcessesByName } from './nativeAttach';
+import { PipeTransportSession } from './pipeTransportSession';
 import { AttachItem, showQuickPick } from './attachQuickPick';
 import { CppSettings } from '../LanguageServer/settings';
 
@@ -17,19 +18,30 @@ import * as nls from 'vscode-nls';
 nls.config({ messageFormat: nls.MessageFormat.bundle, bundleFormat: nls.BundleFormat.standalone })();
 const localize: nls.LocalizeFunc = nls.loadMessageBundle();
 
+// The "processFilter" property of an attach configuration.
+export interface ProcessFilter {
+    name?: string;
+    user?: string;
+}
+
 export interface AttachItemsProvider {
-    getAttachItems(): Promise<AttachItem[]>;
+    // onPartialResult may be called with the (unsorted) items found so far while the list is being built.
+    getAttachItems(onPartialResult?: (items: AttachItem[]) => void, filter?: ProcessFilter): Promise<AttachItem[]>;
 }
 
 export class AttachPicker {
+    // How often the list is refreshed while the QuickPick is open.
+    private static readonly liveRefreshInterval: number = 3000;
+
     constructor(private attachItemsProvider: AttachItemsProvider) { }
 
     // We should not await on this function.
-    public async ShowAttachEntries(): Promise<string | undefined> {
+    public async ShowAttachEntries(config?: any): Promise<string | undefined> {
         if (!await util.isExtensionReady()) {
             util.displayExtensionNotReadyPrompt();
         } else {
-            return showQuickPick(() => this.attachItemsProvider.getAttachItems());
+            const filter: ProcessFilter | undefined = config ? config.processFilter : undefined;
+            return showQuickPick(onPartialResult => this.attachItemsProvider.getAttachItems(onPartialResult, filter), AttachPicker.liveRefreshInterval);
         }
     }
 }
@@ -40,6 +52,14 @@ export class RemoteAttachPicker {
     }
 
     private _channel: vscode.OutputChannel;
+    // Remote shells used to list processes, keyed by pipe command. They are kept open between attaches, so that
+    // later attaches don't connect again, and close themselves when they have been idle for a while.
+    private sessions: Map<string, PipeTransportSession> = new Map<string, PipeTransportSession>();
+
+    public dispose(): void {
+        this.disposeSessions();
+        this._channel.dispose();
+    }
 
     public async ShowAttachEntries(config: any): Promise<string | undefined> {
         if (!await util.isExtensionReady()) {
@@ -87,7 +107,7 @@ export class RemoteAttachPicker {
 
             const pipeCmd: string = `"${pipeProgram}" ${argList}`;
 
-            const processes: AttachItem[]= await this.getRemoteOSAndProcesses(pipeCmd);
+            const processes: AttachItem[] = await this.getRemoteOSAndProcesses(pipeCmd);
             const attachPickOptions: vscode.QuickPickOptions = {
                 matchOnDetail: true,
                 matchOnDescription: true,
@@ -131,6 +151,56 @@ export class RemoteAttachPicker {
     }
 
     private async getRemoteOSAndProcesses(pipeCmd: string): Promise<AttachItem[]> {
+        let session: PipeTransportSession | undefined = this.sessions.get(pipeCmd);
+        if (!session || !session.isAlive) {
+            session = new PipeTransportSession(pipeCmd, data => this._channel.append(data));
+            this.sessions.set(pipeCmd, session);
+        }
+
+        let remoteOS: string = "";
+        const processes: Process[] = [];
+        try {
+            remoteOS = await session.getRemoteOS();
+            if (remoteOS === "Linux" || remoteOS === "Darwin") {
+                // The first line is the header of the table.
+                let isHeader: boolean = true;
+                await session.run(remoteOS === "Linux" ? PsProcessParser.psLinuxCommand : PsProcessParser.psDarwinCommand, line => {
+                    if (isHeader) {
+                        isHeader = false;
+                    } else if (line) {
+                        const processEntry: Process | undefined = PsProcessParser.ParseProcessFromPsLine(line);
+                        if (processEntry) {
+                            processes.push(processEntry);
+                        }
+                    }
+                });
+            }
+        } catch (err) {
+            session.dispose();
+            this.sessions.delete(pipeCmd);
+            // Some pipe programs don't keep stdin open (e.g. 'docker exec' without '-i'). Fall back to running the
+            // whole script as a single command. Other errors, like failing to connect, are reported.
+            if (session.isStdinClosed) {
+                return this.getRemoteOSAndProcessesWithSingleCommand(pipeCmd);
+            }
+            throw err;
+        }
+
+        if (remoteOS !== "Linux" && remoteOS !== "Darwin") {
+            throw new Error(`Operating system "${remoteOS}" not supported.`);
+        }
+        if (processes.length === 0) {
+            throw new Error(localize("no.process.list", "Transport attach could not obtain processes list."));
+        }
+        return sortProcessesByName(processes).map(p => p.toAttachItem());
+    }
+
+    private disposeSessions(): void {
+        this.sessions.forEach(session => session.dispose());
+        this.sessions.clear();
+    }
+
+    private async getRemoteOSAndProcessesWithSingleCommand(pipeCmd: string): Promise<AttachItem[]> {
         // Do not add any quoting in execCommand.
         const execCommand: string = `${pipeCmd} ${this.getRemoteProcessCommand()}`;
 
@@ -152,25 +222,7 @@ export class RemoteAttachPicker {
                 throw new Error(localize("no.process.list", "Transport attach could not obtain processes list."));
             } else {
                 const processes: string[] = lines.slice(1);
-                return PsProcessParser.ParseProcessFromPsArray(processes)
-                    .sort((a, b) => {
-                        if (a.name === undefined) {
-                            if (b.name === undefined) {
-                                return 0;
-                            }
-                            return 1;
-                        }
-                        if (b.name === undefined) {
-                            return -1;
-                        }
-                        const aLower: string = a.name.toLowerCase();
-                        const bLower: string = b.name.toLowerCase();
-                        if (aLower === bLower) {
-                            return 0;
-                        }
-                        return aLower < bLower ? -1 : 1;
-                    })
-                    .map(p => p.toAttachItem());
+                return sortProcessesByName(PsProcessParser.ParseProcessFromPsArray(processes)).map(p => p.toAttachItem());
             }
         }
     }
@@ -0,0 +1,210 @@
+/* --------------------------------------------------------------------------------------------
+ * Copyright (c) Microsoft Corporation. All Rights Reserved.
+ * See 'LICENSE' in the project root for license information.
+ * ------------------------------------------------------------------------------------------ */
+
+import * as vscode from 'vscode';
+import * as logger from '../logger';
+import { CppSettings } from '../LanguageServer/settings';
+import * as nls from 'vscode-nls';
+
+nls.config({ messageFormat: nls.MessageFormat.bundle, bundleFormat: nls.BundleFormat.standalone })();
+const localize: nls.LocalizeFunc = nls.loadMessageBundle();
+
+// A "compounds" entry in launch.json.
+interface CompoundConfiguration {
+    name: string;
+    configurations: (string | { name: string; folder?: string })[];
+    preLaunchTask?: string;
+    // Not supported; see CompoundLauncher.
+    stopAll?: boolean;
+    presentation?: object;
+}
+
+interface CompoundItem extends vscode.QuickPickItem {
+    compound: CompoundConfiguration;
+    folder?: vscode.WorkspaceFolder;
+}
+
+interface LaunchTarget {
+    name: string;
+    folder?: vscode.WorkspaceFolder;
+}
+
+interface LaunchResult {
+    target: LaunchTarget;
+    started: boolean;
+    startupTime: number;
+    error?: string;
+}
+
+/**
+ * Runs task for each of the items, with at most limit of them running at once.
+ * The results are returned in the order of the items.
+ */
+export async function runWithConcurrencyLimit<T, R>(items: T[], limit: number, task: (item: T) => Promise<R>): Promise<R[]> {
+    const results: R[] = new Array<R>(items.length);
+    let next: number = 0;
+    const runNext = async (): Promise<void> => {
+        while (next < items.length) {
+            const index: number = next++;
+            results[index] = await task(items[index]);
+        }
+    };
+    const workers: Promise<void>[] = [];
+    const workerCount: number = Math.min(Math.max(limit, 1), items.length);
+    for (let i: number = 0; i < workerCount; ++i) {
+        workers.push(runNext());
+    }
+    await Promise.all(workers);
+    return results;
+}
+
+/**
+ * Starts the configurations of a compound launch concurrently, instead of one after the other, so that
+ * their configuration resolution and debug adapter startup overlap. At most C_Cpp.debugger.compoundLaunchParallelism
+ * sessions are starting at once. The startup time of each configuration is written to the output channel.
+ * The sessions are independent once started: "stopAll" and "presentation" aren't supported, and a notice is
+ * written to the output channel when a compound sets them.
+ */
+export class CompoundLauncher {
+    public async pickAndLaunch(): Promise<void> {
+        const items: CompoundItem[] = this.getCompounds();
+        if (items.length === 0) {
+            vscode.window.showInformationMessage(localize("no.compound.configurations", "No compound configurations were found in launch.json."));
+            return;
+        }
+        const selection: CompoundItem | undefined = await vscode.window.showQuickPick(items, {
+            placeHolder: localize("select.compound.configuration", "Select a compound configuration")
+        });
+        if (selection) {
+            await this.launch(selection.compound, selection.folder);
+        }
+    }
+
+    public async launch(compound: CompoundConfiguration, folder?: vscode.WorkspaceFolder): Promise<void> {
+        if (compound.preLaunchTask && !await this.runPreLaunchTask(compound.preLaunchTask)) {
+            return;
+        }
+
+        const targets: LaunchTarget[] = compound.configurations.map(configuration => {
+            if (typeof configuration === "string") {
+                return { name: configuration, folder: folder };
+            }
+            const targetFolder: vscode.WorkspaceFolder | undefined = configuration.folder ?
+                vscode.workspace.workspaceFolders?.find(f => f.name === configuration.folder) : folder;
+            return { name: configuration.name, folder: targetFolder };
+        });
+
+        const unsupported: string[] = [];
+        if (compound.stopAll !== undefined) {
+            unsupported.push("stopAll");
+        }
+        if (compound.presentation !== undefined) {
+            unsupported.push("presentation");
+        }
+        if (unsupported.length > 0) {
+            logger.getOutputChannel().appendLine(localize("compound.launch.unsupported", "Compound launch '{0}': {1} is not supported and is ignored.",
+                compound.name, unsupported.join(", ")));
+        }
+
+        const parallelism: number = new CppSettings().compoundLaunchParallelism ?? 8;
+        const start: number = Date.now();
+        const results: LaunchResult[] = await runWithConcurrencyLimit(targets, parallelism, async (target: LaunchTarget) => {
+            const targetStart: number = Date.now();
+            try {
+                const started: boolean = await vscode.debug.startDebugging(target.folder, target.name);
+                return { target: target, started: started, startupTime: Date.now() - targetStart };
+            } catch (errJS) {
+                const e: Error = errJS as Error;
+                return { target: target, started: false, startupTime: Date.now() - targetStart, error: e.message };
+            }
+        });
+        this.report(compound, results, parallelism, Date.now() - start);
+    }
+
+    private getCompounds(): CompoundItem[] {
+        const items: CompoundItem[] = [];
+        const addCompounds = (compounds: CompoundConfiguration[] | undefined, description?: string, folder?: vscode.WorkspaceFolder): void => {
+            for (const compound of compounds ?? []) {
+                if (compound.name && compound.configurations) {
+                    items.push({ label: compound.name, description: description, compound: compound, folder: folder });
+                }
+            }
+        };
+        const folders: vscode.WorkspaceFolder[] = vscode.workspace.workspaceFolders ? [...vscode.workspace.workspaceFolders] : [];
+        if (!vscode.workspace.workspaceFile) {
+            // A single folder, where the workspace and folder settings are the same.
+            for (const folder of folders) {
+                addCompounds(vscode.workspace.getConfiguration("launch", folder.uri).get<CompoundConfiguration[]>("compounds"), undefined, folder);
+            }
+            return items;
+        }
+        // getConfiguration with a folder merges in the workspace's compounds, so they are read once, without a folder,
+        // and only the compounds of each folder's launch.json are read per folder.
+        for (const folder of folders) {
+            addCompounds(vscode.workspace.getConfiguration("launch", folder.uri).inspect<CompoundConfiguration[]>("compounds")?.workspaceFolderValue,
+                folders.length > 1 ? folder.name : undefined, folder);
+        }
+        const workspaceCompounds: { globalValue?: CompoundConfiguration[]; workspaceValue?: CompoundConfiguration[] } | undefined =
+            vscode.workspace.getConfiguration("launch").inspect<CompoundConfiguration[]>("compounds");
+        addCompounds(workspaceCompounds?.workspaceValue ?? workspaceCompounds?.globalValue, localize("compound.workspace", "workspace"));
+        return items;
+    }
+
+    private async runPreLaunchTask(name: string): Promise<boolean> {
+        const task: vscode.Task | undefined = (await vscode.tasks.fetchTasks()).find(t => t.name === name);
+        if (!task) {
+            vscode.window.showErrorMessage(localize("compound.task.not.found", "Could not find the task '{0}'.", name));
+            return false;
+        }
+        // onDidEndTask fires for all tasks, including ones without a process (e.g. only 'dependsOn', or CustomExecution).
+        // Tasks with a process fire onDidEndTaskProcess, with the exit code, before it.
+        const ended: vscode.TaskExecution[] = [];
+        const exitCodes: Map<vscode.TaskExecution, number | undefined> = new Map<vscode.TaskExecution, number | undefined>();
+        let onEnded: (() => void) | undefined;
+        // Listen before the task starts, so that a task that ends quickly isn't missed.
+        const listeners: vscode.Disposable[] = [
+            vscode.tasks.onDidEndTaskProcess(e => exitCodes.set(e.execution, e.exitCode)),
+            vscode.tasks.onDidEndTask(e => {
+                ended.push(e.execution);
+                if (onEnded) {
+                    onEnded();
+                }
+            })
+        ];
+        let exitCode: number | undefined;
+        try {
+            const execution: vscode.TaskExecution = await vscode.tasks.executeTask(task);
+            // Only this execution counts, not a task with the same name in another folder.
+            while (ended.indexOf(execution) < 0) {
+                await new Promise<void>(resolve => { onEnded = resolve; });
+            }
+            exitCode = exitCodes.has(execution) ? exitCodes.get(execution) : 0;
+        } finally {
+            listeners.forEach(listener => listener.dispose());
+        }
+        if (exitCode !== 0) {
+            vscode.window.showErrorMessage(localize("compound.task.failed", "The task '{0}' exited with code {1}.", name, exitCode ?? "undefined"));
+            return false;
+        }
+        return true;
+    }
+
+    private report(compound: CompoundConfiguration, results: LaunchResult[], parallelism: number, totalTime: number): void {
+        const started: number = results.filter(result => result.started).length;
+        const lines: string[] = [localize("compound.launch.summary", "Compound launch '{0}': started {1} of {2} configurations in {3} ms, with up to {4} starting at once.",
+            compound.name, started, results.length, totalTime, parallelism)];
+        for (const result of results) {
+            const name: string = result.target.folder ? `${result.target.name} (${result.target.folder.name})` : result.target.name;
+            lines.push(result.started ?
+                `    ${localize("compound.launch.started", "{0}: started in {1} ms", name, result.startupTime)}` :
+                `    ${localize("compound.launch.failed", "{0}: failed to start after {1} ms {2}", name, result.startupTime, result.error ?? "")}`);
+        }
+        const outputChannel: vscode.OutputChannel = logger.getOutputChannel();
+        outputChannel.appendLine(lines.join("\n"));
+        if (started < results.length) {
+            logger.showOutputChannel();
+        }
+    }
+}
@@ -20,6 +20,7 @@ import { IConfiguration, IConfigurationSnippet, DebuggerType, MIConfigurations,
 import { parse } from 'comment-json';
 import { PlatformInformation } from '../platform';
 import { Environment, ParsedEnvironmentFile } from './ParsedEnvironmentFile';
+import { isCoreDumpTriage } from './coreDumpTriage';
 
 nls.config({ messageFormat: nls.MessageFormat.bundle, bundleFormat: nls.BundleFormat.standalone })();
 const localize: nls.LocalizeFunc = nls.loadMessageBundle();
@@ -106,6 +107,85 @@ export class QuickPickConfigurationProvider implements vscode.DebugConfiguration
     }
 }
 
+interface CatalogEntry {
+    configurations: Promise<vscode.DebugConfiguration[]>;
+    // Whether each file that was looked for exists.
+    probedFiles: Map<string, boolean>;
+}
+
+/**
+ * Debug configurations generated for the Run/Debug picker, keyed by debugger type, the active file's type and the
+ * compilers that can build it. Generating them reads tasks.json and looks for compilers and debuggers on disk,
+ * so they are reused until tasks, launch configurations or C/C++ settings change. The files that generating them
+ * looked for are checked again when they are reused, so that e.g. installing gdb next to the compiler is noticed.
+ */
+class DebugConfigurationCatalog {
+    private entries: Map<string, CatalogEntry> = new Map<string, CatalogEntry>();
+
+    public async get(key: string, generate: (probedFiles: Map<string, boolean>) => Promise<vscode.DebugConfiguration[]>): Promise<vscode.DebugConfiguration[]> {
+        let entry: CatalogEntry | undefined = this.entries.get(key);
+        if (entry && !await this.isCurrent(entry)) {
+            if (this.entries.get(key) === entry) {
+                this.entries.delete(key);
+            }
+            entry = undefined;
+        }
+        if (!entry) {
+            const probedFiles: Map<string, boolean> = new Map<string, boolean>();
+            const generated: CatalogEntry = { configurations: generate(probedFiles), probedFiles: probedFiles };
+            this.entries.set(key, generated);
+            generated.configurations.catch(() => {
+                if (this.entries.get(key) === generated) {
+                    this.entries.delete(key);
+                }
+            });
+            entry = generated;
+        }
+        // Return copies, since the configurations are modified when they are resolved.
+        return JSON.parse(JSON.stringify(await entry.configurations));
+    }
+
+    public clear(): void {
+        this.entries.clear();
+    }
+
+    private async isCurrent(entry: CatalogEntry): Promise<boolean> {
+        try {
+            await entry.configurations;
+        } catch (e) {
+            return false;
+        }
+        const checks: Promise<boolean>[] = [];
+        entry.probedFiles.forEach((exists: boolean, filePath: string) => {
+            checks.push(util.checkFileExists(filePath).then(existsNow => existsNow === exists));
+        });
+        return (await Promise.all(checks)).every(unchanged => unchanged);
+    }
+}
+
+export const debugConfigurationCatalog: DebugConfigurationCatalog = new DebugConfigurationCatalog();
+
+// The resolved sourceFileMap of configurations, keyed by their inputs, so that launching the same configuration
+// again (e.g. the sessions of a compound launch) doesn't resolve the same variables again. envFiles are cached
+// separately, by ParsedEnvironmentFile, until they change.
+// Cleared when any setting changes, since variables can refer to settings.
+const resolvedSourceFileMaps: Map<string, any> = new Map<string, any>();
+const maxResolvedSourceFileMaps: number = 50;
+
+export function clearResolvedVariablesCache(): void {
+    resolvedSourceFileMaps.clear();
+}
+
+// Clears the cached debug configurations and resolved variables that depend on the changed settings.
+export function onDidChangeDebugConfigurationInputs(e: vscode.ConfigurationChangeEvent): void {
+    // Resolved variables can refer to any setting with ${config:...}.
+    clearResolvedVariablesCache();
+    // The generated debug configurations depend on tasks.json, launch.json and C/C++ settings.
+    if (e.affectsConfiguration("tasks") || e.affectsConfiguration("launch") || e.affectsConfiguration("C_Cpp")) {
+        debugConfigurationCatalog.clear();
+    }
+}
+
 class CppConfigurationProvider implements vscode.DebugConfigurationProvider {
     private type: DebuggerType;
     private provider: IConfigurationAssetProvider;
@@ -119,6 +199,16 @@ class CppConfigurationProvider implements vscode.DebugConfigurationProvider {
 	 * Returns a list of initial debug configurations based on contextual information, e.g. package.json or folder.
 	 */
     async provideDebugConfigurations(folder?: vscode.WorkspaceFolder, token?: vscode.CancellationToken): Promise<vscode.DebugConfiguration[]> {
+        const tasksKey: string | undefined = await cppBuildTaskProvider.getTasksKey();
+        if (tasksKey === undefined) {
+            return this.generateDebugConfigurations();
+        }
+        const key: string = JSON.stringify([this.type, folder?.uri.toString(), tasksKey]);
+        return debugConfigurationCatalog.get(key, (probedFiles: Map<string, boolean>) => this.generateDebugConfigurations(probedFiles));
+    }
+
+    // The files that are looked for are added to probedFiles, if it is provided.
+    private async generateDebugConfigurations(probedFiles?: Map<string, boolean>): Promise<vscode.DebugConfiguration[]> {
         const defaultConfig: vscode.DebugConfiguration = this.provider.getInitialConfigurations(this.type).find((config: any) =>
             isDebugLaunchStr(config.name) && config.request === "launch");
         console.assert(defaultConfig, "Could not find default debug configuration.");
@@ -229,12 +319,11 @@ class CppConfigurationProvider implements vscode.DebugConfigurationProvider {
                         newConfig.miDebuggerPath = debuggerPath;
                         return resolve(newConfig);
                     } else {
-                        fs.stat(debuggerPath, (err, stats: fs.Stats) => {
-                            if (!err && stats && stats.isFile) {
-                                newConfig.miDebuggerPath = debuggerPath;
-                            } else {
-                                newConfig.miDebuggerPath = path.join("/usr", "bin", debuggerName);
+                        util.checkFileExists(debuggerPath).then(exists => {
+                            if (probedFiles) {
+                                probedFiles.set(debuggerPath, exists);
                             }
+                            newConfig.miDebuggerPath = exists ? debuggerPath : path.join("/usr", "bin", debuggerName);
                             return resolve(newConfig);
                         });
                     }
@@ -280,7 +369,7 @@ class CppConfigurationProvider implements vscode.DebugConfigurationProvider {
      *
 	 * Try to add all missing attributes to the debug configuration being launched.
 	 */
-    resolveDebugConfigurationWithSubstitutedVariables(folder: vscode.WorkspaceFolder | undefined, config: vscode.DebugConfiguration, token?: vscode.CancellationToken): vscode.ProviderResult<vscode.DebugConfiguration> {
+    async resolveDebugConfigurationWithSubstitutedVariables(folder: vscode.WorkspaceFolder | undefined, config: vscode.DebugConfiguration, token?: vscode.CancellationToken): Promise<vscode.DebugConfiguration | null | undefined> {
         // [Microsoft/vscode#54213] If config or type is not specified, return null to trigger VS Code to call provideDebugConfigurations
         if (!config || !config.type) {
             return null;
@@ -299,10 +388,14 @@ class CppConfigurationProvider implements vscode.DebugConfigurationProvider {
             }
         }
 
-        // Add environment variables from .env file
-        this.resolveEnvFile(config, folder);
+        // Add environment variables from .env file, and resolve the variables in sourceFileMap.
+        await this.resolveEnvFileAndSourceFileMap(config, folder);
 
-        this.resolveSourceFileMapVariables(config);
+        // Core dump triage defers loading shared library symbols, unless symbol loading is set explicitly.
+        // The libraries on the crashing thread's stack are loaded when the core is opened (see CoreDumpTriageAdapter).
+        if (isCoreDumpTriage(config) && !config.symbolLoadInfo) {
+            config.symbolLoadInfo = { loadAll: false, exceptionList: "" };
+        }
 
         // Modify WSL config for OpenDebugAD7
         if (os.platform() === 'win32' &&
@@ -396,18 +489,51 @@ class CppConfigurationProvider implements vscode.DebugConfigurationProvider {
         return undefined;
     }
 
-    private resolveEnvFile(config: vscode.DebugConfiguration, folder?: vscode.WorkspaceFolder): void {
-        if (config.envFile) {
-            // replace ${env:???} variables
-            let envFilePath: string = util.resolveVariables(config.envFile, undefined);
+    private async resolveEnvFileAndSourceFileMap(config: vscode.DebugConfiguration, folder?: vscode.WorkspaceFolder): Promise<void> {
+        // The parsed envFile is cached until it changes.
+        await this.resolveEnvFile(config, folder);
+        if (!config.sourceFileMap) {
+            return;
+        }
+
+        // The result depends on the sourceFileMap from launch.json and the active file (${file} etc.).
+        const key: string = JSON.stringify([
+            folder?.uri.toString(),
+            vscode.window.activeTextEditor?.document.uri.toString(),
+            config.sourceFileMap
+        ]);
+        const cached: any = resolvedSourceFileMaps.get(key);
+        if (cached) {
+            // Copy the cached value, since configurations can be modified after they are resolved.
+            config.sourceFileMap = JSON.parse(JSON.stringify(cached));
+            return;
+        }
 
+        this.resolveSourceFileMapVariables(config);
+
+        if (resolvedSourceFileMaps.size >= maxResolvedSourceFileMaps) {
+            resolvedSourceFileMaps.clear();
+        }
+        resolvedSourceFileMaps.set(key, JSON.parse(JSON.stringify(config.sourceFileMap)));
+    }
+
+    private getEnvFilePath(config: vscode.DebugConfiguration, folder?: vscode.WorkspaceFolder): string {
+        // replace ${env:???} variables
+        let envFilePath: string = util.resolveVariables(config.envFile, undefined);
+        if (folder && folder.uri && folder.uri.fsPath) {
+            // Try to replace ${workspaceFolder} or ${workspaceRoot}
+            envFilePath = envFilePath.replace(/(\${workspaceFolder}|\${workspaceRoot})/g, folder.uri.fsPath);
+        }
+        return envFilePath;
+    }
+
+    private async resolveEnvFile(config: vscode.DebugConfiguration, folder?: vscode.WorkspaceFolder): Promise<void> {
+        if (config.envFile) {
             try {
-                if (folder && folder.uri && folder.uri.fsPath) {
-                    // Try to replace ${workspaceFolder} or ${workspaceRoot}
-                    envFilePath = envFilePath.replace(/(\${workspaceFolder}|\${workspaceRoot})/g, folder.uri.fsPath);
-                }
+                const envFilePath: string = this.getEnvFilePath(config, folder);
 
-                const parsedFile: ParsedEnvironmentFile = ParsedEnvironmentFile.CreateFromFile(envFilePath, config["environment"]);
+                // The parsed file is cached until it changes, so launching again doesn't re-read it.
+                const parsedFile: ParsedEnvironmentFile = await ParsedEnvironmentFile.CreateFromFileAsync(envFilePath, config["environment"]);
 
                 // show error message if single lines cannot get parsed
                 if (parsedFile.Warning) {
@@ -546,6 +672,10 @@ abstract class DefaultConfigurationProvider implements IConfigurationAssetProvid
         this.configurations.forEach(configuration => {
             completionItems.push(convertConfigurationSnippetToCompetionItem(configuration.GetLaunchConfiguration()));
             completionItems.push(convertConfigurationSnippetToCompetionItem(configuration.GetAttachConfiguration()));
+            const coreDumpSnippet: IConfigurationSnippet | undefined = configuration.GetCoreDumpConfiguration ? configuration.GetCoreDumpConfiguration() : undefined;
+            if (coreDumpSnippet) {
+                completionItems.push(convertConfigurationSnippetToCompetionItem(coreDumpSnippet));
+            }
         });
 
         return completionItems;
@@ -80,6 +80,7 @@ function createPipeTransportString(pipeProgram: string, debuggerProgram: string,
 export interface IConfiguration {
     GetLaunchConfiguration(): IConfigurationSnippet;
     GetAttachConfiguration(): IConfigurationSnippet;
+    GetCoreDumpConfiguration?(): IConfigurationSnippet | undefined;
 }
 
 abstract class Configuration implements IConfiguration {
@@ -141,6 +142,34 @@ export class MIConfigurations extends Configuration {
         };
 
     }
+
+    public GetCoreDumpConfiguration(): IConfigurationSnippet | undefined {
+        // Core dump triage loads symbols with gdb's 'sharedlibrary' command.
+        if (this.MIMode !== "gdb") {
+            return undefined;
+        }
+
+        const name: string = `(${this.MIMode}) ${localize("core.dump.triage", "Core Dump Triage").replace(/\"/g, "\\\"")}`;
+
+        const body: string = formatString(`{
+\t"name": "${name}",
+\t"type": "${this.miDebugger}",
+\t"request": "launch",
+\t"program": "${localize("enter.program.name", "enter program name, for example {0}", "$\{workspaceFolder\}" + "/" + this.executable).replace(/\"/g, "\\\"")}",
+\t"coreDumpPath": "${localize("enter.core.dump.path", "enter core dump path, for example {0}", "$\{workspaceFolder\}/core").replace(/\"/g, "\\\"")}",
+\t"coreDumpTriage": true,
+\t"cwd": "$\{workspaceFolder\}",
+\t"MIMode": "${this.MIMode}"{0}{1}
+}`, [this.miDebugger === "cppdbg" && os.platform() === "win32" ? `,${os.EOL}\t"miDebuggerPath": "/path/to/gdb"` : "",
+            this.additionalProperties ? `,${os.EOL}\t${indentJsonString(this.additionalProperties)}` : ""]);
+
+        return {
+            "label": this.snippetPrefix + name,
+            "description": localize("core.dump.triage.with", "Open a core dump with {0}, loading symbols only for the crashing thread.", this.MIMode).replace(/\"/g, "\\\""),
+            "bodyText": body.trim(),
+            "debuggerType": DebuggerType.cppdbg
+        };
+    }
 }
 
 export class PipeTransportConfigurations extends Configuration {
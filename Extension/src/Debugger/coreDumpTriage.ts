@@ -0,0 +1,167 @@
+/* --------------------------------------------------------------------------------------------
+ * Copyright (c) Microsoft Corporation. All Rights Reserved.
+ * See 'LICENSE' in the project root for license information.
+ * ------------------------------------------------------------------------------------------ */
+
+import * as child_process from 'child_process';
+import * as path from 'path';
+import * as vscode from 'vscode';
+import * as logger from '../logger';
+import { PersistentState } from '../LanguageServer/persistentState';
+import { ProcessDebugAdapter } from './debugAdapterPool';
+import * as nls from 'vscode-nls';
+
+nls.config({ messageFormat: nls.MessageFormat.bundle, bundleFormat: nls.BundleFormat.standalone })();
+const localize: nls.LocalizeFunc = nls.loadMessageBundle();
+
+// The time it took to load a core dump of each program with all symbols, to report the time saved by triage.
+const maxLoadTimes: number = 50;
+function getLoadTimes(): PersistentState<{ [program: string]: number }> {
+    return new PersistentState<{ [program: string]: number }>("CPP.coreDumpLoadTimes", {});
+}
+
+// Core dump triage is a cppdbg launch with 'coreDumpPath' and 'coreDumpTriage'. It relies on gdb's 'sharedlibrary' command.
+export function isCoreDumpTriage(config: vscode.DebugConfiguration): boolean {
+    return config.type === "cppdbg" && !!config.coreDumpPath && !!config.coreDumpTriage && config.MIMode !== "lldb";
+}
+
+// Returns the names of the libraries that the frames are in, not including the program itself.
+export function getFrameLibraries(frames: any[], modules: Map<string, string>, program: string): string[] {
+    const libraries: Set<string> = new Set<string>();
+    const programName: string = path.basename(program);
+    for (const frame of frames) {
+        let library: string | undefined;
+        if (frame.moduleId !== undefined && modules.has(String(frame.moduleId))) {
+            library = modules.get(String(frame.moduleId));
+        } else if (typeof frame.name === "string") {
+            // Frames without symbols are named <module>!<function>. Function names can contain '!' too (e.g. operator!=).
+            const match: RegExpMatchArray | null = frame.name.match(/^([^\s!()]+\.so(\.[\d.]+)?)!/);
+            if (match) {
+                library = match[1];
+            }
+        }
+        if (library) {
+            library = path.basename(library);
+            if (library !== programName) {
+                libraries.add(library);
+            }
+        }
+    }
+    const result: string[] = [];
+    libraries.forEach(library => result.push(library));
+    return result;
+}
+
+/**
+ * Runs a core dump triage session. The configuration defers loading shared library symbols (see symbolLoadInfo), so the
+ * core loads quickly. When it has loaded, the first stopped event is held back while the crashing thread's stack is fetched
+ * and symbols are loaded for just the libraries on it, so that its frames have symbols when VS Code shows them.
+ */
+export class CoreDumpTriageAdapter extends ProcessDebugAdapter {
+    // Requests sent by the triage use sequence numbers that VS Code's requests won't reach.
+    private static readonly firstSeq: number = 1000000000;
+    private static readonly requestTimeout: number = 30000;
+    private static readonly maxFrames: number = 100;
+
+    private startTime: number = Date.now();
+    private triaged: boolean = false;
+    private nextSeq: number = CoreDumpTriageAdapter.firstSeq;
+    private pending: Map<number, (response: any) => void> = new Map<number, (response: any) => void>();
+    private modules: Map<string, string> = new Map<string, string>();
+
+    constructor(adapter: child_process.ChildProcess, private program: string) {
+        super(adapter);
+    }
+
+    protected onAdapterMessage(message: any): void {
+        if (message.type === "response") {
+            const onResponse: ((response: any) => void) | undefined = this.pending.get(message.request_seq);
+            if (onResponse) {
+                this.pending.delete(message.request_seq);
+                onResponse(message);
+                return;
+            }
+        } else if (message.type === "event") {
+            if (message.event === "module" && message.body && message.body.module) {
+                this.modules.set(String(message.body.module.id), message.body.module.path || message.body.module.name);
+            } else if (message.event === "stopped" && !this.triaged) {
+                this.triaged = true;
+                this.triage(message.body ? message.body.threadId : undefined).then(() => super.onAdapterMessage(message), () => super.onAdapterMessage(message));
+                return;
+            }
+        }
+        super.onAdapterMessage(message);
+    }
+
+    private async triage(threadId?: number): Promise<void> {
+        const loadTime: number = Date.now() - this.startTime;
+        const symbolsStart: number = Date.now();
+        let libraries: string[] = [];
+        if (threadId !== undefined) {
+            const stack: any = await this.request("stackTrace", { threadId: threadId, startFrame: 0, levels: CoreDumpTriageAdapter.maxFrames });
+            const frames: any[] = stack && stack.stackFrames ? stack.stackFrames : [];
+            libraries = getFrameLibraries(frames, this.modules, this.program);
+            for (const library of libraries) {
+                // 'sharedlibrary' takes a regular expression.
+                const pattern: string = library.replace(/[.*+?^${}()|[\]\\]/g, "\\$&");
+                await this.request("evaluate", { expression: `-exec sharedlibrary ${pattern}`, context: "repl", frameId: frames.length > 0 ? frames[0].id : undefined });
+            }
+        }
+        this.report(loadTime, libraries.length, Date.now() - symbolsStart);
+    }
+
+    // Sends a request to the debug adapter and returns the body of its response, or undefined if it failed.
+    private request(command: string, args: any): Promise<any> {
+        return new Promise<any>(resolve => {
+            const seq: number = this.nextSeq++;
+            const timer: NodeJS.Timer = global.setTimeout(() => {
+                this.pending.delete(seq);
+                resolve(undefined);
+            }, CoreDumpTriageAdapter.requestTimeout);
+            this.pending.set(seq, (response: any) => {
+                global.clearTimeout(timer);
+                resolve(response.success ? response.body : undefined);
+            });
+            this.sendToAdapter(<vscode.DebugProtocolMessage>{ seq: seq, type: "request", command: command, arguments: args });
+        });
+    }
+
+    private report(loadTime: number, libraryCount: number, symbolsTime: number): void {
+        let message: string = localize("core.dump.triage.loaded", "Core dump triage: the core dump of {0} was loaded in {1} ms without shared library symbols. Symbols for the {2} libraries on the crashing thread's stack were loaded in {3} ms.",
+            path.basename(this.program), loadTime, libraryCount, symbolsTime);
+        const fullLoadTime: number | undefined = getLoadTimes().Value[this.program];
+        if (fullLoadTime !== undefined) {
+            message += " " + localize("core.dump.triage.saved", "Loading it with all symbols last took {0} ms ({1} ms saved).", fullLoadTime, fullLoadTime - loadTime - symbolsTime);
+        }
+        logger.getOutputChannel().appendLine(message);
+    }
+}
+
+/**
+ * Records how long core dumps take to load with all symbols (i.e. without triage), which the triage reports compare to.
+ */
+export class CoreDumpLoadTimeTrackerFactory implements vscode.DebugAdapterTrackerFactory {
+    createDebugAdapterTracker(session: vscode.DebugSession): vscode.ProviderResult<vscode.DebugAdapterTracker> {
+        const config: vscode.DebugConfiguration = session.configuration;
+        if (!config.coreDumpPath || !config.program || isCoreDumpTriage(config)) {
+            return undefined;
+        }
+        const start: number = Date.now();
+        let recorded: boolean = false;
+        return {
+            onDidSendMessage: (message: any) => {
+                if (!recorded && message.type === "event" && message.event === "stopped") {
+                    recorded = true;
+                    const loadTimes: PersistentState<{ [program: string]: number }> = getLoadTimes();
+                    const value: { [program: string]: number } = { ...loadTimes.Value };
+                    const programs: string[] = Object.keys(value);
+                    if (programs.length >= maxLoadTimes && value[config.program] === undefined) {
+                        delete value[programs[0]];
+                    }
+                    value[config.program] = Date.now() - start;
+                    loadTimes.Value = value;
+                }
+            }
+        };
+    }
+}
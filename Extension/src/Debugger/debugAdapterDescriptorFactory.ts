@@ -4,10 +4,14 @@
  * ------------------------------------------------------------------------------------------ */
 
 import * as vscode from "vscode";
+import * as child_process from 'child_process';
 import * as util from '../common';
 import * as path from 'path';
 import * as os from 'os';
 import * as nls from 'vscode-nls';
+import { CppSettings } from '../LanguageServer/settings';
+import { DebugAdapterPool, ProcessDebugAdapter, spawnDebugAdapter } from './debugAdapterPool';
+import { CoreDumpTriageAdapter, isCoreDumpTriage } from './coreDumpTriage';
 
 nls.config({ messageFormat: nls.MessageFormat.bundle, bundleFormat: nls.BundleFormat.standalone })();
 const localize: nls.LocalizeFunc = nls.loadMessageBundle();
@@ -26,25 +30,84 @@ abstract class AbstractDebugAdapterDescriptorFactory implements vscode.DebugAdap
     abstract createDebugAdapterDescriptor(session: vscode.DebugSession, executable?: vscode.DebugAdapterExecutable): vscode.ProviderResult<vscode.DebugAdapterDescriptor>;
 }
 
-export class CppdbgDebugAdapterDescriptorFactory extends AbstractDebugAdapterDescriptorFactory {
+export class CppdbgDebugAdapterDescriptorFactory extends AbstractDebugAdapterDescriptorFactory implements vscode.Disposable {
     public static DEBUG_TYPE: string = "cppdbg";
 
+    // Only used if C_Cpp.debugger.prewarmDebugAdapter is set.
+    private pool: DebugAdapterPool | undefined;
+    private settingListener: vscode.Disposable;
+
     constructor(context: vscode.ExtensionContext) {
         super(context);
+        this.updatePool();
+        this.settingListener = vscode.workspace.onDidChangeConfiguration(e => {
+            if (e.affectsConfiguration("C_Cpp.debugger.prewarmDebugAdapter")) {
+                this.updatePool();
+            }
+        });
     }
 
     async createDebugAdapterDescriptor(session: vscode.DebugSession, executable?: vscode.DebugAdapterExecutable): Promise<vscode.DebugAdapterDescriptor> {
         if (await util.isExtensionReady()) {
+            let adapter: child_process.ChildProcess | undefined;
+            if (new CppSettings().prewarmDebugAdapter) {
+                adapter = this.getPool().take();
+            }
 
-            const adapter: string = "./debugAdapters/bin/OpenDebugAD7" + (os.platform() === 'win32' ? ".exe" : "");
-
-            const command: string = path.join(this.context.extensionPath, adapter);
+            // Core dump triage needs to see the adapter's messages, so it always runs the adapter itself.
+            if (isCoreDumpTriage(session.configuration)) {
+                if (!adapter) {
+                    adapter = spawnDebugAdapter(this.getAdapterCommand(), []);
+                }
+                return new vscode.DebugAdapterInlineImplementation(new CoreDumpTriageAdapter(adapter, session.configuration.program));
+            }
+            if (adapter) {
+                return new vscode.DebugAdapterInlineImplementation(new ProcessDebugAdapter(adapter));
+            }
 
-            return new vscode.DebugAdapterExecutable(command, []);
+            return new vscode.DebugAdapterExecutable(this.getAdapterCommand(), []);
         } else {
             throw new Error(util.extensionNotReadyString);
         }
     }
+
+    dispose(): void {
+        this.settingListener.dispose();
+        this.disposePool();
+    }
+
+    // Starts the idle adapter when the setting is turned on, and stops it when it is turned off.
+    private updatePool(): void {
+        if (new CppSettings().prewarmDebugAdapter) {
+            util.isExtensionReady().then(ready => {
+                if (ready && new CppSettings().prewarmDebugAdapter) {
+                    this.getPool().prespawn();
+                }
+            });
+        } else {
+            this.disposePool();
+        }
+    }
+
+    private disposePool(): void {
+        if (this.pool) {
+            this.pool.dispose();
+            this.pool = undefined;
+        }
+    }
+
+    private getAdapterCommand(): string {
+        const adapter: string = "./debugAdapters/bin/OpenDebugAD7" + (os.platform() === 'win32' ? ".exe" : "");
+
+        return path.join(this.context.extensionPath, adapter);
+    }
+
+    private getPool(): DebugAdapterPool {
+        if (!this.pool) {
+            this.pool = new DebugAdapterPool(this.getAdapterCommand(), []);
+        }
+        return this.pool;
+    }
 }
 
 export class CppvsdbgDebugAdapterDescriptorFactory extends AbstractDebugAdapterDescriptorFactory {
@@ -0,0 +1,159 @@
+/* --------------------------------------------------------------------------------------------
+ * Copyright (c) Microsoft Corporation. All Rights Reserved.
+ * See 'LICENSE' in the project root for license information.
+ * ------------------------------------------------------------------------------------------ */
+
+import * as child_process from 'child_process';
+import * as vscode from 'vscode';
+
+// Starts a debug adapter process. Errors starting it are ignored here; ProcessDebugAdapter ends the session.
+export function spawnDebugAdapter(command: string, args: string[]): child_process.ChildProcess {
+    const adapter: child_process.ChildProcess = child_process.spawn(command, args, { stdio: "pipe" });
+    adapter.on("error", () => { });
+    (adapter.stderr as NodeJS.ReadableStream).resume();
+    return adapter;
+}
+
+/**
+ * Keeps one debug adapter process started ahead of time, so that a debug session doesn't wait for the
+ * adapter's runtime to start. When the idle process is taken, a replacement is started in the background.
+ */
+export class DebugAdapterPool implements vscode.Disposable {
+    // The replacement is started after a delay, so it doesn't compete with the session that took the idle process.
+    private static readonly replacementDelay: number = 2000;
+
+    private idle: child_process.ChildProcess | undefined;
+    private replacementTimer: NodeJS.Timer | undefined;
+
+    constructor(private command: string, private args: string[]) { }
+
+    // Returns the idle process if there is one that is still running, and starts its replacement.
+    public take(): child_process.ChildProcess | undefined {
+        const adapter: child_process.ChildProcess | undefined = this.idle;
+        this.idle = undefined;
+        if (!this.replacementTimer) {
+            this.replacementTimer = global.setTimeout(() => {
+                this.replacementTimer = undefined;
+                this.prespawn();
+            }, DebugAdapterPool.replacementDelay);
+        }
+        if (adapter && adapter.pid !== undefined && adapter.exitCode === null && !adapter.killed) {
+            return adapter;
+        }
+        return undefined;
+    }
+
+    public prespawn(): void {
+        if (this.idle) {
+            return;
+        }
+        const adapter: child_process.ChildProcess = spawnDebugAdapter(this.command, this.args);
+        adapter.on("exit", () => {
+            if (this.idle === adapter) {
+                this.idle = undefined;
+            }
+        });
+        this.idle = adapter;
+    }
+
+    public dispose(): void {
+        if (this.replacementTimer) {
+            global.clearTimeout(this.replacementTimer);
+            this.replacementTimer = undefined;
+        }
+        if (this.idle) {
+            this.idle.kill();
+            this.idle = undefined;
+        }
+    }
+}
+
+/**
+ * Runs a debug session with an already started debug adapter process, exchanging Debug Adapter Protocol
+ * messages with it over stdin and stdout.
+ */
+export class ProcessDebugAdapter implements vscode.DebugAdapter {
+    private sendMessage: vscode.EventEmitter<vscode.DebugProtocolMessage> = new vscode.EventEmitter<vscode.DebugProtocolMessage>();
+    private buffer: Buffer = Buffer.alloc(0);
+    private contentLength: number = -1;
+    private disposed: boolean = false;
+    private exited: boolean = false;
+
+    readonly onDidSendMessage: vscode.Event<vscode.DebugProtocolMessage> = this.sendMessage.event;
+
+    constructor(private adapter: child_process.ChildProcess) {
+        (adapter.stdout as NodeJS.ReadableStream).on("data", (data: Buffer) => this.onData(data));
+        // Writes fail (EPIPE) once the adapter has exited, which is reported by the exit event.
+        (adapter.stdin as NodeJS.WritableStream).on("error", () => { });
+        adapter.on("exit", () => this.onExit());
+        adapter.on("error", () => this.onExit());
+    }
+
+    handleMessage(message: vscode.DebugProtocolMessage): void {
+        this.sendToAdapter(message);
+    }
+
+    dispose(): void {
+        this.disposed = true;
+        this.adapter.kill();
+        this.sendMessage.dispose();
+    }
+
+    // Sends a message to the debug adapter process.
+    protected sendToAdapter(message: vscode.DebugProtocolMessage): void {
+        if (this.exited || this.disposed) {
+            return;
+        }
+        const json: string = JSON.stringify(message);
+        (this.adapter.stdin as NodeJS.WritableStream).write(`Content-Length: ${Buffer.byteLength(json, "utf8")}\r\n\r\n${json}`, "utf8");
+    }
+
+    // Called with each message from the debug adapter process. Forwards it to VS Code.
+    protected onAdapterMessage(message: any): void {
+        this.sendMessage.fire(message);
+    }
+
+    // End the session if the adapter exits unexpectedly, or fails to start.
+    private onExit(): void {
+        if (this.exited) {
+            return;
+        }
+        this.exited = true;
+        if (!this.disposed) {
+            this.sendMessage.fire(<vscode.DebugProtocolMessage>{ seq: 0, type: "event", event: "terminated" });
+        }
+    }
+
+    private onData(data: Buffer): void {
+        this.buffer = Buffer.concat([this.buffer, data]);
+        for (;;) {
+            if (this.contentLength < 0) {
+                const headerEnd: number = this.buffer.indexOf("\r\n\r\n");
+                if (headerEnd < 0) {
+                    return;
+                }
+                const header: string = this.buffer.toString("utf8", 0, headerEnd);
+                const match: RegExpExecArray | null = /Content-Length: *(\d+)/i.exec(header);
+                this.buffer = this.buffer.slice(headerEnd + 4);
+                if (!match) {
+                    continue;
+                }
+                this.contentLength = parseInt(match[1], 10);
+            }
+            if (this.buffer.length < this.contentLength) {
+                return;
+            }
+            const content: string = this.buffer.toString("utf8", 0, this.contentLength);
+            this.buffer = this.buffer.slice(this.contentLength);
+            this.contentLength = -1;
+            let message: any;
+            try {
+                message = JSON.parse(content);
+            } catch (e) {
+                // Ignore malformed messages.
+                continue;
+            }
+            this.onAdapterMessage(message);
+        }
+    }
+}
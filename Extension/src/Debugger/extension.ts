@@ -7,8 +7,10 @@ import * as vscode from 'vscode';
 import * as os from 'os';
 import { AttachPicker, RemoteAttachPicker, AttachItemsProvider } from './attachToProcess';
 import { NativeAttachItemsProviderFactory } from './nativeAttach';
-import { QuickPickConfigurationProvider, ConfigurationAssetProviderFactory, CppVsDbgConfigurationProvider, CppDbgConfigurationProvider, ConfigurationSnippetProvider, IConfigurationAssetProvider } from './configurationProvider';
+import { QuickPickConfigurationProvider, debugConfigurationCatalog, clearResolvedVariablesCache, onDidChangeDebugConfigurationInputs, ConfigurationAssetProviderFactory, CppVsDbgConfigurationProvider, CppDbgConfigurationProvider, ConfigurationSnippetProvider, IConfigurationAssetProvider } from './configurationProvider';
 import { CppdbgDebugAdapterDescriptorFactory, CppvsdbgDebugAdapterDescriptorFactory } from './debugAdapterDescriptorFactory';
+import { CompoundLauncher } from './compoundLaunch';
+import { CoreDumpLoadTimeTrackerFactory } from './coreDumpTriage';
 import * as util from '../common';
 import * as Telemetry from '../telemetry';
 import * as nls from 'vscode-nls';
@@ -26,11 +28,27 @@ export function buildAndDebugActiveFileStr(): string {
 
 export function initialize(context: vscode.ExtensionContext): void {
     // Activate Process Picker Commands
-    const attachItemsProvider: AttachItemsProvider = NativeAttachItemsProviderFactory.Get();
-    const attacher: AttachPicker = new AttachPicker(attachItemsProvider);
-    disposables.push(vscode.commands.registerCommand('extension.pickNativeProcess', () => attacher.ShowAttachEntries()));
-    const remoteAttacher: RemoteAttachPicker = new RemoteAttachPicker();
-    disposables.push(vscode.commands.registerCommand('extension.pickRemoteNativeProcess', (any) => remoteAttacher.ShowAttachEntries(any)));
+    // The pickers are created on first use, since most sessions never attach to a process.
+    let attacher: AttachPicker | undefined;
+    disposables.push(vscode.commands.registerCommand('extension.pickNativeProcess', (any) => {
+        if (!attacher) {
+            const attachItemsProvider: AttachItemsProvider = NativeAttachItemsProviderFactory.Get();
+            attacher = new AttachPicker(attachItemsProvider);
+        }
+        return attacher.ShowAttachEntries(any);
+    }));
+    let remoteAttacher: RemoteAttachPicker | undefined;
+    disposables.push(vscode.commands.registerCommand('extension.pickRemoteNativeProcess', (any) => {
+        if (!remoteAttacher) {
+            remoteAttacher = new RemoteAttachPicker();
+        }
+        return remoteAttacher.ShowAttachEntries(any);
+    }));
+    disposables.push(new vscode.Disposable(() => {
+        if (remoteAttacher) {
+            remoteAttacher.dispose();
+        }
+    }));
 
     // Activate ConfigurationProvider
     const configurationProvider: IConfigurationAssetProvider = ConfigurationAssetProviderFactory.getConfigurationProvider();
@@ -44,6 +62,12 @@ export function initialize(context: vscode.ExtensionContext): void {
     const provider: CppDbgConfigurationProvider = new CppDbgConfigurationProvider(configurationProvider);
     disposables.push(vscode.debug.registerDebugConfigurationProvider('cppdbg', new QuickPickConfigurationProvider(provider)));
 
+    disposables.push(vscode.workspace.onDidChangeConfiguration(onDidChangeDebugConfigurationInputs));
+    disposables.push(vscode.workspace.onDidChangeWorkspaceFolders(() => {
+        debugConfigurationCatalog.clear();
+        clearResolvedVariablesCache();
+    }));
+
     disposables.push(vscode.commands.registerTextEditorCommand("C_Cpp.BuildAndDebugActiveFile", async (textEditor: vscode.TextEditor, edit: vscode.TextEditorEdit, ...args: any[]) => {
         const folder: vscode.WorkspaceFolder | undefined = vscode.workspace.getWorkspaceFolder(textEditor.document.uri);
         if (!folder) {
@@ -128,6 +152,8 @@ export function initialize(context: vscode.ExtensionContext): void {
         }
     }));
 
+    disposables.push(vscode.commands.registerCommand("C_Cpp.StartCompoundLaunch", () => new CompoundLauncher().pickAndLaunch()));
+
     configurationProvider.getConfigurationSnippets();
 
     const launchJsonDocumentSelector: vscode.DocumentSelector = [{
@@ -141,7 +167,10 @@ export function initialize(context: vscode.ExtensionContext): void {
 
     // Register Debug Adapters
     disposables.push(vscode.debug.registerDebugAdapterDescriptorFactory(CppvsdbgDebugAdapterDescriptorFactory.DEBUG_TYPE, new CppvsdbgDebugAdapterDescriptorFactory(context)));
-    disposables.push(vscode.debug.registerDebugAdapterDescriptorFactory(CppdbgDebugAdapterDescriptorFactory.DEBUG_TYPE, new CppdbgDebugAdapterDescriptorFactory(context)));
+    const cppdbgDebugAdapterDescriptorFactory: CppdbgDebugAdapterDescriptorFactory = new CppdbgDebugAdapterDescriptorFactory(context);
+    disposables.push(cppdbgDebugAdapterDescriptorFactory);
+    disposables.push(vscode.debug.registerDebugAdapterDescriptorFactory(CppdbgDebugAdapterDescriptorFactory.DEBUG_TYPE, cppdbgDebugAdapterDescriptorFactory));
+    disposables.push(vscode.debug.registerDebugAdapterTrackerFactory(CppdbgDebugAdapterDescriptorFactory.DEBUG_TYPE, new CoreDumpLoadTimeTrackerFactory()));
 
     vscode.Disposable.from(...disposables);
 }
@@ -4,8 +4,9 @@
  * ------------------------------------------------------------------------------------------ */
 
 import * as child_process from 'child_process';
+import * as fs from 'fs';
 import * as os from 'os';
-import { AttachItemsProvider } from './attachToProcess';
+import { AttachItemsProvider, ProcessFilter } from './attachToProcess';
 import { AttachItem } from './attachQuickPick';
 import * as nls from 'vscode-nls';
 
@@ -29,38 +30,176 @@ export class NativeAttachItemsProviderFactory {
     static Get(): AttachItemsProvider {
         if (os.platform() === 'win32') {
             return new WmicAttachItemsProvider();
+        } else if (os.platform() === 'linux' && fs.existsSync('/proc/self/cmdline')) {
+            return new ProcFsAttachItemsProvider();
         } else {
             return new PsAttachItemsProvider();
         }
     }
 }
 
+/**
+ * Sorts processes case-insensitively by name, with unnamed processes last.
+ */
+export function sortProcessesByName(processes: Process[]): Process[] {
+    // The lowercase sort keys are computed once per process instead of once per comparison.
+    // localeCompare is significantly slower than < and > (2000 ms vs 80 ms for 10,000 elements)
+    // We can change to localeCompare if this becomes an issue
+    const keyedProcesses: { key?: string; process: Process }[] = processes.map(p => ({ key: p.name?.toLowerCase(), process: p }));
+    keyedProcesses.sort((a, b) => {
+        if (a.key === undefined) {
+            if (b.key === undefined) {
+                return 0;
+            }
+            return 1;
+        }
+        if (b.key === undefined) {
+            return -1;
+        }
+        if (a.key === b.key) {
+            return 0;
+        }
+        return a.key < b.key ? -1 : 1;
+    });
+    return keyedProcesses.map(p => p.process);
+}
+
+interface ProcessTableEntry {
+    process: Process;
+    item: AttachItem;
+}
+
+/**
+ * The processes found by the last enumeration. Updating the table keeps the AttachItems of processes
+ * that did not change, and only rebuilds the sorted list when processes were added, removed or changed.
+ */
+export class ProcessTable {
+    private entries: Map<string, ProcessTableEntry> = new Map<string, ProcessTableEntry>();
+    private items: AttachItem[] = [];
+
+    // The items sorted by name. The same array is returned until the table changes.
+    public get Items(): AttachItem[] {
+        return this.items;
+    }
+
+    // Returns true if the list of items changed.
+    public update(processes: Process[]): boolean {
+        const entries: Map<string, ProcessTableEntry> = new Map<string, ProcessTableEntry>();
+        let changed: boolean = false;
+        for (const process of processes) {
+            const key: string = ProcessTable.getKey(process);
+            const existing: ProcessTableEntry | undefined = this.entries.get(key);
+            if (existing && existing.process.name === process.name && existing.process.commandLine === process.commandLine) {
+                entries.set(key, existing);
+            } else {
+                entries.set(key, { process: process, item: process.toAttachItem() });
+                changed = true;
+            }
+        }
+        changed = changed || entries.size !== this.entries.size;
+        this.entries = entries;
+        if (changed) {
+            const sortedProcesses: Process[] = sortProcessesByName(Array.from(entries.values(), entry => entry.process));
+            this.items = sortedProcesses.map(process => (entries.get(ProcessTable.getKey(process)) as ProcessTableEntry).item);
+        }
+        return changed;
+    }
+
+    private static getKey(process: Process): string {
+        return process.pid ?? process.name;
+    }
+}
+
+function matchesNameFilter(process: Process, lowerCaseName: string): boolean {
+    return (process.name !== undefined && process.name.toLowerCase().indexOf(lowerCaseName) >= 0) ||
+        (process.commandLine !== undefined && process.commandLine.toLowerCase().indexOf(lowerCaseName) >= 0);
+}
+
 abstract class NativeAttachItemsProvider implements AttachItemsProvider {
-    protected abstract getInternalProcessEntries(): Promise<Process[]>;
-
-    async getAttachItems(): Promise<AttachItem[]> {
-        const processEntries: Process[] = await this.getInternalProcessEntries();
-        // localeCompare is significantly slower than < and > (2000 ms vs 80 ms for 10,000 elements)
-        // We can change to localeCompare if this becomes an issue
-        processEntries.sort((a, b) => {
-            if (a.name === undefined) {
-                if (b.name === undefined) {
-                    return 0;
+    // Kept between calls so that refreshing the list only applies the differences.
+    private processTable: ProcessTable = new ProcessTable();
+
+    // Implementations filter by user. Filtering by name is done here.
+    protected abstract getInternalProcessEntries(onPartialResult?: (processes: Process[]) => void, user?: string): Promise<Process[]>;
+
+    async getAttachItems(onPartialResult?: (items: AttachItem[]) => void, filter?: ProcessFilter): Promise<AttachItem[]> {
+        const name: string | undefined = filter?.name ? filter.name.toLowerCase() : undefined;
+        const applyNameFilter = (processes: Process[]) => name ? processes.filter(p => matchesNameFilter(p, name)) : processes;
+        const onPartialProcesses: ((processes: Process[]) => void) | undefined = onPartialResult ?
+            (processes: Process[]) => onPartialResult(sortProcessesByName(applyNameFilter(processes)).map(p => p.toAttachItem())) : undefined;
+        const processEntries: Process[] = await this.getInternalProcessEntries(onPartialProcesses, filter?.user);
+        this.processTable.update(applyNameFilter(processEntries));
+        return this.processTable.Items;
+    }
+}
+
+export class ProcFsAttachItemsProvider extends NativeAttachItemsProvider {
+    // Reads /proc/<pid>/comm and /proc/<pid>/cmdline directly instead of spawning ps and parsing its output.
+    // The reads are done concurrently, but bounded to avoid running out of file handles.
+    private static readonly maxConcurrentReads: number = 64;
+    // The number of processes read between partial results.
+    private static readonly partialResultInterval: number = 1000;
+
+    protected async getInternalProcessEntries(onPartialResult?: (processes: Process[]) => void, user?: string): Promise<Process[]> {
+        const uid: number | undefined = user ? await ProcFsAttachItemsProvider.getUserId(user) : undefined;
+        const pids: string[] = (await fs.promises.readdir('/proc')).filter(name => /^[0-9]+$/.test(name));
+        const processes: Process[] = [];
+        let nextPidIndex: number = 0;
+        const readProcesses = async (): Promise<void> => {
+            while (nextPidIndex < pids.length) {
+                const process: Process | undefined = await ProcFsAttachItemsProvider.readProcess(pids[nextPidIndex++], uid);
+                if (process) {
+                    processes.push(process);
+                    if (onPartialResult && processes.length % ProcFsAttachItemsProvider.partialResultInterval === 0) {
+                        onPartialResult(processes.slice());
+                    }
                 }
-                return 1;
             }
-            if (b.name === undefined) {
-                return -1;
+        };
+        const readers: Promise<void>[] = [];
+        for (let i: number = 0; i < Math.min(ProcFsAttachItemsProvider.maxConcurrentReads, pids.length); ++i) {
+            readers.push(readProcesses());
+        }
+        await Promise.all(readers);
+        return processes;
+    }
+
+    private static async getUserId(user: string): Promise<number> {
+        if (/^[0-9]+$/.test(user)) {
+            return parseInt(user, 10);
+        }
+        const passwd: string = await fs.promises.readFile('/etc/passwd', 'utf8');
+        for (const line of passwd.split('\n')) {
+            const fields: string[] = line.split(':');
+            if (fields.length > 2 && fields[0] === user) {
+                return parseInt(fields[2], 10);
             }
-            const aLower: string = a.name.toLowerCase();
-            const bLower: string = b.name.toLowerCase();
-            if (aLower === bLower) {
-                return 0;
+        }
+        throw new Error(localize("unknown.user", 'Unknown user "{0}".', user));
+    }
+
+    private static async readProcess(pid: string, uid?: number): Promise<Process | undefined> {
+        try {
+            // The /proc/<pid> directory is owned by the user the process runs as.
+            if (uid !== undefined && (await fs.promises.stat(`/proc/${pid}`)).uid !== uid) {
+                return undefined;
             }
-            return aLower < bLower ? -1 : 1;
-        });
-        const attachItems: AttachItem[] = processEntries.map(p => p.toAttachItem());
-        return attachItems;
+            const [comm, cmdline] = await Promise.all([
+                fs.promises.readFile(`/proc/${pid}/comm`, 'utf8'),
+                fs.promises.readFile(`/proc/${pid}/cmdline`, 'utf8')
+            ]);
+            // Like ps, use the 'comm' name (which is truncated to 15 characters) and show kernel threads,
+            // which have no command line, as [name].
+            const name: string = comm.trim();
+            const args: string[] = cmdline.split('\0');
+            if (args[args.length - 1] === '') {
+                args.pop();
+            }
+            return new Process(name, pid, args.length > 0 ? args.join(' ') : `[${name}]`);
+        } catch (e) {
+            // The process exited while the list was being read.
+            return undefined;
+        }
     }
 }
 
@@ -89,14 +228,14 @@ export class PsAttachItemsProvider extends NativeAttachItemsProvider {
     // characters. 50 was chosen because that's the maximum length of a "label" in the
     // QuickPick UI in VSCode.
 
-    protected async getInternalProcessEntries(): Promise<Process[]> {
+    protected async getInternalProcessEntries(onPartialResult?: (processes: Process[]) => void, user?: string): Promise<Process[]> {
         let processCmd: string = '';
         switch (os.platform()) {
             case 'darwin':
-                processCmd = PsProcessParser.psDarwinCommand;
+                processCmd = PsProcessParser.getPsDarwinCommand(user);
                 break;
             case 'linux':
-                processCmd = PsProcessParser.psLinuxCommand;
+                processCmd = PsProcessParser.getPsLinuxCommand(user);
                 break;
             default:
                 throw new Error(localize("os.not.supported", 'Operating system "{0}" not supported.', os.platform()));
@@ -114,8 +253,21 @@ export class PsProcessParser {
     // Note that comm on Linux systems is truncated to 16 characters:
     // https://bugzilla.redhat.com/show_bug.cgi?id=429565
     // Since 'args' contains the full path to the executable, even if truncated, searching will work as desired.
-    public static get psLinuxCommand(): string { return `ps axww -o pid=,comm=${PsProcessParser.commColumnTitle},args=`; }
-    public static get psDarwinCommand(): string { return `ps axww -o pid=,comm=${PsProcessParser.commColumnTitle},args= -c`; }
+    public static get psLinuxCommand(): string { return PsProcessParser.getPsLinuxCommand(); }
+    public static get psDarwinCommand(): string { return PsProcessParser.getPsDarwinCommand(); }
+    public static getPsLinuxCommand(user?: string): string { return `ps ${PsProcessParser.getProcessSelection(user)} -o pid=,comm=${PsProcessParser.commColumnTitle},args=`; }
+    public static getPsDarwinCommand(user?: string): string { return `ps ${PsProcessParser.getProcessSelection(user)} -o pid=,comm=${PsProcessParser.commColumnTitle},args= -c`; }
+
+    // 'ax' selects the processes of all users. 'x -U' selects the processes of one user, including the ones without a terminal.
+    private static getProcessSelection(user?: string): string {
+        if (!user) {
+            return 'axww';
+        }
+        if (!/^[A-Za-z0-9._$-]+$/.test(user)) {
+            throw new Error(localize("invalid.user", 'Invalid user name "{0}".', user));
+        }
+        return `xww -U ${user}`;
+    }
 
     // Only public for tests.
     public static ParseProcessFromPs(processes: string): Process[] {
@@ -133,7 +285,7 @@ export class PsProcessParser {
                 continue;
             }
 
-            const processEntry: Process | undefined = PsProcessParser.parseLineFromPs(line);
+            const processEntry: Process | undefined = PsProcessParser.ParseProcessFromPsLine(line);
             if (processEntry) {
                 processEntries.push(processEntry);
             }
@@ -142,7 +294,7 @@ export class PsProcessParser {
         return processEntries;
     }
 
-    private static parseLineFromPs(line: string): Process | undefined {
+    public static ParseProcessFromPsLine(line: string): Process | undefined {
         // Explanation of the regex:
         //   - any leading whitespace
         //   - PID
@@ -0,0 +1,218 @@
+/* --------------------------------------------------------------------------------------------
+ * Copyright (c) Microsoft Corporation. All Rights Reserved.
+ * See 'LICENSE' in the project root for license information.
+ * ------------------------------------------------------------------------------------------ */
+
+import * as child_process from 'child_process';
+import * as readline from 'readline';
+import * as nls from 'vscode-nls';
+
+nls.config({ messageFormat: nls.MessageFormat.bundle, bundleFormat: nls.BundleFormat.standalone })();
+const localize: nls.LocalizeFunc = nls.loadMessageBundle();
+
+interface PendingCommand {
+    onLine: (line: string) => void;
+    resolve: () => void;
+    reject: (error: Error) => void;
+    stderr: string;
+    // The last line of output is held back until the next line or the marker arrives (see runNow).
+    lastLine?: string;
+    exitCode?: string;
+    stderrDone: boolean;
+}
+
+/**
+ * A shell on the remote machine, started once through the pipe transport (e.g. ssh) and reused for
+ * several commands, so that each command doesn't pay for a new connection. Commands are written to the
+ * remote shell's stdin one at a time, and their output is reported line by line as it arrives.
+ * The end of each command's output is detected by a marker line that also carries its exit code, and
+ * a marker line on stderr, since stderr is read from a separate pipe and can arrive after stdout.
+ *
+ * Does not use vscode, so it can be tested with a local shell script standing in for the pipe program.
+ */
+export class PipeTransportSession {
+    // Close the connection if it hasn't been used for a while.
+    private static readonly idleTimeout: number = 10 * 60 * 1000;
+
+    private child: child_process.ChildProcess | undefined;
+    private alive: boolean = true;
+    private marker: string = `__cpptools_done_${process.pid}_${Date.now()}__`;
+    private current: PendingCommand | undefined;
+    private queue: Promise<void> = Promise.resolve();
+    private idleTimer: NodeJS.Timer | undefined;
+    private remoteOS: Promise<string> | undefined;
+    private stdinClosed: boolean = false;
+
+    // pipeCmd is the quoted pipe program and arguments. onStderr receives the remote shell's error output.
+    constructor(private pipeCmd: string, private onStderr?: (data: string) => void, private commandTimeout: number = 30000) { }
+
+    public get isAlive(): boolean {
+        return this.alive;
+    }
+
+    /**
+     * True if the remote shell stopped reading commands because its stdin was closed, which happens
+     * with pipe programs that don't forward stdin (e.g. 'docker exec' without '-i').
+     */
+    public get isStdinClosed(): boolean {
+        return this.stdinClosed;
+    }
+
+    /**
+     * Runs a shell command on the remote machine. Commands are run one after the other, in the order
+     * they were requested. Rejects if the command fails, times out, or the connection is lost.
+     */
+    public run(command: string, onLine: (line: string) => void): Promise<void> {
+        const result: Promise<void> = this.queue.then(() => this.runNow(command, onLine));
+        this.queue = result.catch(() => { });
+        return result;
+    }
+
+    // Returns the output of 'uname' on the remote machine. It is only queried once per session.
+    public getRemoteOS(): Promise<string> {
+        if (!this.remoteOS) {
+            let remoteOS: string = "";
+            this.remoteOS = this.run("uname", line => { remoteOS = remoteOS || line.trim(); }).then(() => remoteOS);
+            this.remoteOS.catch(() => { this.remoteOS = undefined; });
+        }
+        return this.remoteOS;
+    }
+
+    public dispose(): void {
+        this.alive = false;
+        this.clearIdleTimer();
+        if (this.child) {
+            this.child.kill();
+            this.child = undefined;
+        }
+        this.fail(new Error(localize("pipe.session.closed", "Pipe transport session was closed.")));
+    }
+
+    private runNow(command: string, onLine: (line: string) => void): Promise<void> {
+        return new Promise<void>((resolve, reject) => {
+            if (!this.alive) {
+                reject(new Error(localize("pipe.session.closed", "Pipe transport session was closed.")));
+                return;
+            }
+            this.clearIdleTimer();
+            const child: child_process.ChildProcess = this.child ?? this.start();
+            const timer: NodeJS.Timer = global.setTimeout(() => {
+                // The remote shell can't be reused if a command doesn't finish.
+                this.fail(new Error(localize("pipe.session.timeout", "Pipe transport command timed out: {0}", command)));
+                this.dispose();
+            }, this.commandTimeout);
+            this.current = {
+                onLine: onLine,
+                resolve: () => {
+                    global.clearTimeout(timer);
+                    this.idleTimer = global.setTimeout(() => this.dispose(), PipeTransportSession.idleTimeout);
+                    resolve();
+                },
+                reject: (error: Error) => {
+                    global.clearTimeout(timer);
+                    reject(error);
+                },
+                stderr: "",
+                stderrDone: false
+            };
+            // Write the markers after the command's output, with the exit code on stdout. They start with a newline, in case
+            // the output doesn't end with one. That adds an empty line if it did, which onLine removes.
+            (child.stdin as NodeJS.WritableStream).write(`${command}\n__cpptools_status=$?\n` +
+                `printf '\\n%s\\n' "${this.marker}" >&2\nprintf '\\n%s %s\\n' "${this.marker}" "$__cpptools_status"\n`);
+        });
+    }
+
+    private start(): child_process.ChildProcess {
+        // The pipe program runs 'sh' on the remote machine, which reads commands from stdin.
+        const child: child_process.ChildProcess = child_process.spawn(`${this.pipeCmd} sh`, { shell: true });
+        this.child = child;
+        readline.createInterface({ input: child.stdout as NodeJS.ReadableStream }).on("line", (line: string) => this.onLine(line.replace(/\r$/, "")));
+        (child.stderr as NodeJS.ReadableStream).on("data", (data: Buffer | string) => this.onStderrData(data.toString()));
+        // Errors writing to stdin are reported when the process exits.
+        (child.stdin as NodeJS.WritableStream).on("error", () => { this.stdinClosed = true; });
+        child.on("error", (error: Error) => {
+            this.alive = false;
+            this.fail(error);
+        });
+        child.on("exit", (code: number | null) => {
+            if (code === 0) {
+                // The remote shell exits successfully when it reaches the end of its stdin.
+                this.stdinClosed = true;
+            }
+            this.alive = false;
+            this.child = undefined;
+            this.clearIdleTimer();
+            this.fail(new Error(localize("pipe.session.exited", "Pipe transport exited with code {0}.", code ?? "null")));
+        });
+        return child;
+    }
+
+    private onLine(line: string): void {
+        const command: PendingCommand | undefined = this.current;
+        if (!command || command.exitCode !== undefined) {
+            return;
+        }
+        if (line.lastIndexOf(this.marker, 0) === 0) {
+            // The line before the marker is empty if the output ended with a newline.
+            if (command.lastLine) {
+                command.onLine(command.lastLine);
+            }
+            command.exitCode = line.slice(this.marker.length).trim();
+            this.settle(command);
+        } else {
+            if (command.lastLine !== undefined) {
+                command.onLine(command.lastLine);
+            }
+            command.lastLine = line;
+        }
+    }
+
+    private onStderrData(text: string): void {
+        const command: PendingCommand | undefined = this.current;
+        if (!command || command.stderrDone) {
+            if (this.onStderr) {
+                this.onStderr(text);
+            }
+            return;
+        }
+        // A command's error output is passed on when its marker arrives, without the marker.
+        command.stderr += text;
+        const markerIndex: number = command.stderr.indexOf(`\n${this.marker}\n`);
+        if (markerIndex >= 0) {
+            command.stderr = command.stderr.slice(0, markerIndex);
+            command.stderrDone = true;
+            if (this.onStderr && command.stderr) {
+                this.onStderr(command.stderr);
+            }
+            this.settle(command);
+        }
+    }
+
+    // Completes the command once both of its markers have arrived.
+    private settle(command: PendingCommand): void {
+        if (command.exitCode === undefined || !command.stderrDone || this.current !== command) {
+            return;
+        }
+        this.current = undefined;
+        if (command.exitCode === "0") {
+            command.resolve();
+        } else {
+            command.reject(new Error(command.stderr.trim() || localize("pipe.command.failed", "Pipe transport command failed with exit code {0}.", command.exitCode)));
+        }
+    }
+
+    private fail(error: Error): void {
+        const command: PendingCommand | undefined = this.current;
+        this.current = undefined;
+        if (command) {
+            command.reject(error);
+        }
+    }
+
+    private clearIdleTimer(): void {
+        if (this.idleTimer) {
+            global.clearTimeout(this.idleTimer);
+            this.idleTimer = undefined;
+        }
+    }
+}
@@ -3,8 +3,14 @@
  * See 'LICENSE' in the project root for license information.
  * ------------------------------------------------------------------------------------------ */
 import * as vscode from 'vscode';
-import { DefaultClient, FormatParams, FormatDocumentRequest } from '../client';
+import { DefaultClient, FormatParams, FormatDocumentRequest, FormatRangeRequest } from '../client';
 import { CppSettings, getEditorConfigSettings } from '../settings';
+import { LineRange } from '../modifiedLinesTracker';
+import { getOutputChannelLogger, LogLevel } from '../../logger';
+import * as nls from 'vscode-nls';
+
+nls.config({ messageFormat: nls.MessageFormat.bundle, bundleFormat: nls.BundleFormat.standalone })();
+const localize: nls.LocalizeFunc = nls.loadMessageBundle();
 
 export class DocumentFormattingEditProvider implements vscode.DocumentFormattingEditProvider {
     private client: DefaultClient;
@@ -17,8 +23,10 @@ export class DocumentFormattingEditProvider implements vscode.DocumentFormatting
         const filePath: string = document.uri.fsPath;
         const settings: CppSettings = new CppSettings(this.client.RootUri);
         const useVcFormat: boolean = settings.useVcFormat(document);
+        // If only modified lines are to be formatted and the modifications are known, format just those ranges.
+        const modifiedLines: LineRange[] | undefined = settings.formatModifiedLinesOnly ? this.client.modifiedLinesTracker.getModifiedLines(document) : undefined;
         const configCallBack = async (editorConfigSettings: any | undefined) => {
-            const params: FormatParams = {
+            const makeParams = (range: vscode.Range): FormatParams => ({
                 editorConfigSettings: { ...editorConfigSettings },
                 useVcFormat: useVcFormat,
                 uri: document.uri.toString(),
@@ -27,46 +35,68 @@ export class DocumentFormattingEditProvider implements vscode.DocumentFormatting
                 character: "",
                 range: {
                     start: {
-                        character: 0,
-                        line: 0
+                        character: range.start.character,
+                        line: range.start.line
                     },
                     end: {
-                        character: 0,
-                        line: 0
+                        character: range.end.character,
+                        line: range.end.line
                     }
                 }
-            };
-            const textEdits: any = await this.client.languageClient.sendRequest(FormatDocumentRequest, params);
-            const results: vscode.TextEdit[] = [];
-            textEdits.forEach((textEdit: any) => {
-                results.push({
-                    range: new vscode.Range(textEdit.range.start.line, textEdit.range.start.character, textEdit.range.end.line, textEdit.range.end.character),
-                    newText: textEdit.newText
-                });
             });
-            // Apply insert_final_newline from .editorconfig
+            let textEdits: any[];
+            if (modifiedLines === undefined) {
+                textEdits = await this.client.languageClient.sendRequest(FormatDocumentRequest, makeParams(new vscode.Range(0, 0, 0, 0)));
+            } else {
+                textEdits = [];
+                for (const lines of mergeNearbyLineRanges(modifiedLines)) {
+                    if (token.isCancellationRequested || lines.startLine >= document.lineCount) {
+                        break;
+                    }
+                    const range: vscode.Range = new vscode.Range(lines.startLine, 0, Math.min(lines.endLine, document.lineCount - 1), Number.MAX_VALUE);
+                    const rangeEdits: any[] = await this.client.languageClient.sendRequest(FormatRangeRequest, makeParams(document.validateRange(range)));
+                    textEdits.push(...rangeEdits);
+                }
+            }
+            // Check if there is already a newline at the end.  If so, formatting edits should not replace it.
+            let endPosition: vscode.Position | undefined;
             if (document.lineCount > 0 && editorConfigSettings !== undefined && editorConfigSettings.insert_final_newline) {
-                // Check if there is already a newline at the end.  If so, formatting edits should not replace it.
                 const lastLine: vscode.TextLine = document.lineAt(document.lineCount - 1);
                 if (!lastLine.isEmptyOrWhitespace) {
-                    const endPosition: vscode.Position = lastLine.range.end;
-                    // Check if there is an existing edit that extends the end of the file.
-                    // It would be the last edit, but edit may not be sorted.  If multiple, we need the last one.
-                    let lastEdit: vscode.TextEdit | undefined;
-                    results.forEach(edit => {
-                        if (edit.range.end.isAfterOrEqual(endPosition) && (!lastEdit || edit.range.start.isAfterOrEqual(lastEdit.range.start)) && edit.newText !== "") {
-                            lastEdit = edit;
-                        }
+                    endPosition = lastLine.range.end;
+                }
+            }
+            const results: vscode.TextEdit[] = [];
+            // Check if there is an existing edit that extends the end of the file.
+            // It would be the last edit, but edit may not be sorted.  If multiple, we need the last one.
+            let lastEdit: vscode.TextEdit | undefined;
+            if (modifiedLines !== undefined) {
+                textEdits = dropOverlappingEdits(textEdits, (edit: any) => getOutputChannelLogger().appendLineAtLevel(LogLevel.Warning, () =>
+                    localize("formatting.edit.dropped", "A formatting edit of {0} at line {1}, column {2} was not applied because it overlaps another edit.",
+                        document.uri.fsPath, edit.range.start.line + 1, edit.range.start.character + 1)));
+            }
+            textEdits.forEach((textEdit: any) => {
+                const edit: vscode.TextEdit | undefined = makeMinimalTextEdit(document,
+                    new vscode.Range(textEdit.range.start.line, textEdit.range.start.character, textEdit.range.end.line, textEdit.range.end.character),
+                    textEdit.newText);
+                if (edit === undefined) {
+                    return;
+                }
+                if (endPosition !== undefined && edit.range.end.isAfterOrEqual(endPosition) && (!lastEdit || edit.range.start.isAfterOrEqual(lastEdit.range.start)) && edit.newText !== "") {
+                    lastEdit = edit;
+                }
+                results.push(edit);
+            });
+            // Apply insert_final_newline from .editorconfig
+            if (endPosition !== undefined) {
+                if (lastEdit === undefined) {
+                    results.push({
+                        range: new vscode.Range(endPosition, endPosition),
+                        newText: "\n"
                     });
-                    if (lastEdit === undefined) {
-                        results.push({
-                            range: new vscode.Range(endPosition, endPosition),
-                            newText: "\n"
-                        });
-                    } else {
-                        if (!lastEdit.newText.endsWith("\n")) {
-                            lastEdit.newText += "\n";
-                        }
+                } else {
+                    if (!lastEdit.newText.endsWith("\n")) {
+                        lastEdit.newText += "\n";
                     }
                 }
             }
@@ -80,3 +110,77 @@ export class DocumentFormattingEditProvider implements vscode.DocumentFormatting
         }
     }
 }
+
+// Modified ranges this close together are formatted as one range, since formatting each of them can change the
+// whitespace between them (e.g. blank lines), which would give overlapping edits.
+const modifiedRangeMergeDistance: number = 3;
+
+export function mergeNearbyLineRanges(ranges: LineRange[]): LineRange[] {
+    const result: LineRange[] = [];
+    for (const range of ranges) {
+        const last: LineRange | undefined = result.length > 0 ? result[result.length - 1] : undefined;
+        if (last && range.startLine - last.endLine <= modifiedRangeMergeDistance) {
+            last.endLine = Math.max(last.endLine, range.endLine);
+        } else {
+            result.push({ startLine: range.startLine, endLine: range.endLine });
+        }
+    }
+    return result;
+}
+
+// VS Code rejects a set of edits if any of them overlap, so an edit that overlaps an earlier one is dropped.
+// onDropped is called with each edit that is dropped.
+export function dropOverlappingEdits(textEdits: any[], onDropped?: (edit: any) => void): any[] {
+    const sorted: any[] = [...textEdits].sort((a, b) =>
+        a.range.start.line - b.range.start.line || a.range.start.character - b.range.start.character);
+    const result: any[] = [];
+    for (const edit of sorted) {
+        const previous: any | undefined = result.length > 0 ? result[result.length - 1] : undefined;
+        if (previous && (edit.range.start.line < previous.range.end.line ||
+            (edit.range.start.line === previous.range.end.line && edit.range.start.character < previous.range.end.character))) {
+            if (onDropped) {
+                onDropped(edit);
+            }
+            continue;
+        }
+        result.push(edit);
+    }
+    return result;
+}
+
+/**
+ * Narrows a formatting edit to the span of text it actually changes, by trimming the text it has
+ * in common with the document at both ends. Returns undefined if the edit changes nothing.
+ */
+export function makeMinimalTextEdit(document: vscode.TextDocument, range: vscode.Range, newText: string): vscode.TextEdit | undefined {
+    const oldText: string = document.getText(range);
+    if (oldText === newText) {
+        return undefined;
+    }
+    const maxLength: number = Math.min(oldText.length, newText.length);
+    let prefixLength: number = 0;
+    while (prefixLength < maxLength && oldText.charCodeAt(prefixLength) === newText.charCodeAt(prefixLength)) {
+        prefixLength++;
+    }
+    let suffixLength: number = 0;
+    while (suffixLength < maxLength - prefixLength
+        && oldText.charCodeAt(oldText.length - 1 - suffixLength) === newText.charCodeAt(newText.length - 1 - suffixLength)) {
+        suffixLength++;
+    }
+    // Avoid splitting a "\r\n" line break.
+    if (prefixLength > 0 && oldText.charCodeAt(prefixLength - 1) === 13 /* \r */) {
+        prefixLength--;
+    }
+    if (suffixLength > 0 && oldText.charCodeAt(oldText.length - suffixLength) === 10 /* \n */
+        && oldText.charCodeAt(oldText.length - suffixLength - 1) === 13 /* \r */) {
+        suffixLength--;
+    }
+    if (prefixLength === 0 && suffixLength === 0) {
+        return { range: range, newText: newText };
+    }
+    const startOffset: number = document.offsetAt(range.start);
+    return {
+        range: new vscode.Range(document.positionAt(startOffset + prefixLength), document.positionAt(startOffset + oldText.length - suffixLength)),
+        newText: newText.substring(prefixLength, newText.length - suffixLength)
+    };
+}
@@ -5,6 +5,7 @@
 import * as vscode from 'vscode';
 import { DefaultClient, FormatParams, FormatRangeRequest } from '../client';
 import { CppSettings, getEditorConfigSettings } from '../settings';
+import { makeMinimalTextEdit } from './documentFormattingEditProvider';
 
 export class DocumentRangeFormattingEditProvider implements vscode.DocumentRangeFormattingEditProvider {
     private client: DefaultClient;
@@ -39,10 +40,12 @@ export class DocumentRangeFormattingEditProvider implements vscode.DocumentRange
             const textEdits: any = await this.client.languageClient.sendRequest(FormatRangeRequest, params);
             const result: vscode.TextEdit[] = [];
             textEdits.forEach((textEdit: any) => {
-                result.push({
-                    range: new vscode.Range(textEdit.range.start.line, textEdit.range.start.character, textEdit.range.end.line, textEdit.range.end.character),
-                    newText: textEdit.newText
-                });
+                const edit: vscode.TextEdit | undefined = makeMinimalTextEdit(document,
+                    new vscode.Range(textEdit.range.start.line, textEdit.range.start.character, textEdit.range.end.line, textEdit.range.end.character),
+                    textEdit.newText);
+                if (edit !== undefined) {
+                    result.push(edit);
+                }
             });
             return result;
         };
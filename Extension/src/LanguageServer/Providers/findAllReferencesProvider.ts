@@ -6,6 +6,7 @@ import * as vscode from 'vscode';
 import { DefaultClient, workspaceReferences, FindAllReferencesParams, ReferencesCancellationState, RequestReferencesNotification, CancelReferencesNotification } from '../client';
 import { Position } from 'vscode-languageclient';
 import * as refs from '../references';
+import { uriInternTable, makeVscodeLineRange } from './internTable';
 
 export class FindAllReferencesProvider implements vscode.ReferenceProvider {
     private client: DefaultClient;
@@ -37,8 +38,8 @@ export class FindAllReferencesProvider implements vscode.ReferenceProvider {
                     if (result) {
                         result.referenceInfos.forEach((referenceInfo: refs.ReferenceInfo) => {
                             if (referenceInfo.type === refs.ReferenceType.Confirmed) {
-                                const uri: vscode.Uri = vscode.Uri.file(referenceInfo.file);
-                                const range: vscode.Range = new vscode.Range(referenceInfo.position.line, referenceInfo.position.character, referenceInfo.position.line, referenceInfo.position.character + result.text.length);
+                                const uri: vscode.Uri = uriInternTable.file(referenceInfo.file);
+                                const range: vscode.Range = makeVscodeLineRange(referenceInfo.position.line, referenceInfo.position.character, result.text.length);
                                 locations.push(new vscode.Location(uri, range));
                             }
                         });
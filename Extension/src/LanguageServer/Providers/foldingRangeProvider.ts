@@ -3,54 +3,118 @@
  * See 'LICENSE' in the project root for license information.
  * ------------------------------------------------------------------------------------------ */
 import * as vscode from 'vscode';
-import { DefaultClient, GetFoldingRangesParams, GetFoldingRangesRequest, FoldingRangeKind, GetFoldingRangesResult, CppFoldingRange } from '../client';
+import { DefaultClient, GetFoldingRangesParams, GetFoldingRangesRequest, FoldingRangeKind, GetFoldingRangesResult, CppFoldingRange, InputRegion } from '../client';
+import { decodeUint32Array } from './payloadDecoding';
+
+function makeFoldingRange(startLine: number, endLine: number, kind: FoldingRangeKind): vscode.FoldingRange {
+    const foldingRange: vscode.FoldingRange = {
+        start: startLine,
+        end: endLine
+    };
+    switch (kind) {
+        case FoldingRangeKind.Comment:
+            foldingRange.kind = vscode.FoldingRangeKind.Comment;
+            break;
+        case FoldingRangeKind.Imports:
+            foldingRange.kind = vscode.FoldingRangeKind.Imports;
+            break;
+        case FoldingRangeKind.Region:
+            foldingRange.kind = vscode.FoldingRangeKind.Region;
+            break;
+        default:
+            break;
+    }
+    return foldingRange;
+}
 
 export class FoldingRangeProvider implements vscode.FoldingRangeProvider {
     private client: DefaultClient;
     public onDidChangeFoldingRangesEvent = new vscode.EventEmitter<void>();
     public onDidChangeFoldingRanges?: vscode.Event<void>;
+    // Folding ranges keyed by document URI, tagged with the document version they were computed for.
+    private foldingRangeCaches: Map<string, [number, vscode.FoldingRange[]]> = new Map<string, [number, vscode.FoldingRange[]]>();
+    // The last set of inactive regions reported for each document, used to skip redundant refreshes.
+    private inactiveRegionCaches: Map<string, InputRegion[]> = new Map<string, InputRegion[]>();
+    // Incremented on every invalidation so that results of requests already in flight are not cached.
+    private cacheGeneration: number = 0;
+
     constructor(client: DefaultClient) {
         this.client = client;
         this.onDidChangeFoldingRanges = this.onDidChangeFoldingRangesEvent.event;
     }
     async provideFoldingRanges(document: vscode.TextDocument, context: vscode.FoldingContext,
         token: vscode.CancellationToken): Promise<vscode.FoldingRange[] | undefined> {
+        const uriString: string = document.uri.toString();
+        // First check the cache to see if we already have results for that file and version
+        const cache: [number, vscode.FoldingRange[]] | undefined = this.foldingRangeCaches.get(uriString);
+        if (cache && cache[0] === document.version) {
+            return cache[1];
+        }
+        const requestVersion: number = document.version;
+        const requestGeneration: number = this.cacheGeneration;
         const id: number = ++DefaultClient.abortRequestId;
         const params: GetFoldingRangesParams = {
             id: id,
-            uri: document.uri.toString()
+            uri: uriString
         };
         await this.client.awaitUntilLanguageClientReady();
+        if (token.isCancellationRequested) {
+            return undefined;
+        }
         token.onCancellationRequested(e => this.client.abortRequest(id));
         const ranges: GetFoldingRangesResult = await this.client.languageClient.sendRequest(GetFoldingRangesRequest, params);
-        if (ranges.canceled) {
+        if (ranges.canceled || token.isCancellationRequested) {
             return undefined;
         }
         const result: vscode.FoldingRange[] = [];
-        ranges.ranges.forEach((r: CppFoldingRange) => {
-            const foldingRange: vscode.FoldingRange = {
-                start: r.range.startLine,
-                end: r.range.endLine
-            };
-            switch (r.kind) {
-                case FoldingRangeKind.Comment:
-                    foldingRange.kind = vscode.FoldingRangeKind.Comment;
-                    break;
-                case FoldingRangeKind.Imports:
-                    foldingRange.kind = vscode.FoldingRangeKind.Imports;
-                    break;
-                case FoldingRangeKind.Region:
-                    foldingRange.kind = vscode.FoldingRangeKind.Region;
-                    break;
-                default:
-                    break;
+        if (ranges.encodedRanges !== undefined) {
+            const data: Uint32Array = decodeUint32Array(ranges.encodedRanges);
+            for (let i: number = 0; i + 2 < data.length; i += 3) {
+                result.push(makeFoldingRange(data[i], data[i + 1], data[i + 2]));
             }
-            result.push(foldingRange);
-        });
+        } else {
+            ranges.ranges.forEach((r: CppFoldingRange) => {
+                result.push(makeFoldingRange(r.range.startLine, r.range.endLine, r.kind));
+            });
+        }
+        // Only cache the result if it was computed for the requested version of the document, the document was not
+        // edited and no invalidation happened while the request was pending.
+        if ((ranges.fileVersion === undefined || ranges.fileVersion === requestVersion)
+            && document.version === requestVersion && this.cacheGeneration === requestGeneration) {
+            this.foldingRangeCaches.set(uriString, [requestVersion, result]);
+        }
         return result;
     }
 
     public refresh(): void {
+        this.cacheGeneration++;
+        this.foldingRangeCaches.clear();
         this.onDidChangeFoldingRangesEvent.fire();
     }
+
+    // Called when the language server reports new inactive regions for a version of a file. Folding ranges are only
+    // recomputed if the set of regions differs from the one previously reported for that file, or the cached
+    // folding ranges are for a different version.
+    public updateInactiveRegions(uri: string, regions: InputRegion[], fileVersion?: number): void {
+        const previousRegions: InputRegion[] | undefined = this.inactiveRegionCaches.get(uri);
+        this.inactiveRegionCaches.set(uri, regions);
+        const cache: [number, vscode.FoldingRange[]] | undefined = this.foldingRangeCaches.get(uri);
+        const cacheIsCurrent: boolean = !cache || fileVersion === undefined || cache[0] === fileVersion;
+        if (cacheIsCurrent && previousRegions && previousRegions.length === regions.length
+            && previousRegions.every((r, i) => r.startLine === regions[i].startLine && r.endLine === regions[i].endLine)) {
+            return;
+        }
+        this.invalidateFile(uri);
+    }
+
+    public invalidateFile(uri: string): void {
+        this.cacheGeneration++;
+        this.foldingRangeCaches.delete(uri);
+        this.onDidChangeFoldingRangesEvent.fire();
+    }
+
+    public removeFile(uri: string): void {
+        this.foldingRangeCaches.delete(uri);
+        this.inactiveRegionCaches.delete(uri);
+    }
 }
@@ -0,0 +1,67 @@
+/* --------------------------------------------------------------------------------------------
+ * Copyright (c) Microsoft Corporation. All Rights Reserved.
+ * See 'LICENSE' in the project root for license information.
+ * ------------------------------------------------------------------------------------------ */
+import * as vscode from 'vscode';
+import { Range } from 'vscode-languageclient';
+
+// Large result sets (workspace symbols, references) refer to the same files many times.
+// Parsing each URI once and sharing the resulting (immutable) vscode.Uri objects avoids
+// re-parsing them and reduces allocations and GC pressure.
+const maxInternedUris: number = 20000;
+
+export class UriInternTable {
+    private parsedUris: Map<string, vscode.Uri> = new Map<string, vscode.Uri>();
+    private fileUris: Map<string, vscode.Uri> = new Map<string, vscode.Uri>();
+
+    // Equivalent to vscode.Uri.parse(uri).
+    public parse(uri: string): vscode.Uri {
+        let result: vscode.Uri | undefined = this.parsedUris.get(uri);
+        if (!result) {
+            result = vscode.Uri.parse(uri);
+            UriInternTable.add(this.parsedUris, uri, result);
+        }
+        return result;
+    }
+
+    // Equivalent to vscode.Uri.file(fsPath).
+    public file(fsPath: string): vscode.Uri {
+        let result: vscode.Uri | undefined = this.fileUris.get(fsPath);
+        if (!result) {
+            result = vscode.Uri.file(fsPath);
+            UriInternTable.add(this.fileUris, fsPath, result);
+        }
+        return result;
+    }
+
+    public get size(): number {
+        return this.parsedUris.size + this.fileUris.size;
+    }
+
+    public clear(): void {
+        this.parsedUris.clear();
+        this.fileUris.clear();
+    }
+
+    private static add(map: Map<string, vscode.Uri>, key: string, uri: vscode.Uri): void {
+        // Bound the memory used by the table. The entries are cheap to recreate.
+        if (map.size >= maxInternedUris) {
+            map.clear();
+        }
+        map.set(key, uri);
+    }
+}
+
+export const uriInternTable: UriInternTable = new UriInternTable();
+
+// Creates a vscode.Range covering `length` characters of a single line.
+// The start and end share a single vscode.Position when the range is empty.
+export function makeVscodeLineRange(line: number, character: number, length: number): vscode.Range {
+    const start: vscode.Position = new vscode.Position(line, character);
+    return new vscode.Range(start, length === 0 ? start : new vscode.Position(line, character + length));
+}
+
+// Creates a vscode.Location from a file URI string and a range received from the language server.
+export function makeVscodeLocation(uri: string, r: Range): vscode.Location {
+    return new vscode.Location(uriInternTable.parse(uri), new vscode.Range(r.start.line, r.start.character, r.end.line, r.end.character));
+}
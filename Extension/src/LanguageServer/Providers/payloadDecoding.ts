@@ -0,0 +1,19 @@
+/* --------------------------------------------------------------------------------------------
+ * Copyright (c) Microsoft Corporation. All Rights Reserved.
+ * See 'LICENSE' in the project root for license information.
+ * ------------------------------------------------------------------------------------------ */
+
+// Decodes a base64 string containing packed little-endian 32-bit unsigned integers, as sent by the
+// language server for encoded semantic token and folding range results. The platforms the language
+// server runs on are all little-endian, so the bytes can be reinterpreted without per-element conversion.
+export function decodeUint32Array(base64: string): Uint32Array {
+    const buffer: Buffer = Buffer.from(base64, "base64");
+    const length: number = Math.floor(buffer.length / Uint32Array.BYTES_PER_ELEMENT);
+    if (buffer.byteOffset % Uint32Array.BYTES_PER_ELEMENT === 0) {
+        return new Uint32Array(buffer.buffer, buffer.byteOffset, length);
+    }
+    // Small buffers may be allocated unaligned within Node's shared buffer pool, so copy them.
+    const result: Uint32Array = new Uint32Array(length);
+    new Uint8Array(result.buffer).set(buffer.subarray(0, length * Uint32Array.BYTES_PER_ELEMENT));
+    return result;
+}
@@ -9,6 +9,7 @@ import { CppSettings } from '../settings';
 import { Position } from 'vscode-languageclient';
 import * as nls from 'vscode-nls';
 import * as util from '../../common';
+import { uriInternTable, makeVscodeLineRange } from './internTable';
 
 nls.config({ messageFormat: nls.MessageFormat.bundle, bundleFormat: nls.BundleFormat.standalone })();
 const localize: nls.LocalizeFunc = nls.loadMessageBundle();
@@ -76,8 +77,8 @@ export class RenameProvider implements vscode.RenameProvider {
                         // If null, return an empty list to avoid Rename failure dialog.
                         if (referencesResult) {
                             for (const reference of referencesResult.referenceInfos) {
-                                const uri: vscode.Uri = vscode.Uri.file(reference.file);
-                                const range: vscode.Range = new vscode.Range(reference.position.line, reference.position.character, reference.position.line, reference.position.character + referencesResult.text.length);
+                                const uri: vscode.Uri = uriInternTable.file(reference.file);
+                                const range: vscode.Range = makeVscodeLineRange(reference.position.line, reference.position.character, referencesResult.text.length);
                                 const metadata: vscode.WorkspaceEditEntryMetadata = {
                                     needsConfirmation: reference.type !== refs.ReferenceType.Confirmed,
                                     label: refs.getReferenceTagString(reference.type, false, true),
@@ -4,6 +4,7 @@
  * ------------------------------------------------------------------------------------------ */
 import * as vscode from 'vscode';
 import { DefaultClient, GetSemanticTokensParams, GetSemanticTokensRequest, openFileVersions, GetSemanticTokensResult } from '../client';
+import { decodeUint32Array } from './payloadDecoding';
 
 export class SemanticTokensProvider implements vscode.DocumentSemanticTokensProvider {
     private client: DefaultClient;
@@ -37,11 +38,17 @@ export class SemanticTokensProvider implements vscode.DocumentSemanticTokensProv
                 if (tokensResult.fileVersion !== openFileVersions.get(uriString)) {
                     throw new vscode.CancellationError();
                 } else {
-                    const builder: vscode.SemanticTokensBuilder = new vscode.SemanticTokensBuilder(this.client.semanticTokensLegend);
-                    tokensResult.tokens.forEach((token) => {
-                        builder.push(token.line, token.character, token.length, token.type, token.modifiers);
-                    });
-                    const tokens: vscode.SemanticTokens = builder.build();
+                    let tokens: vscode.SemanticTokens;
+                    if (tokensResult.encodedTokens !== undefined) {
+                        // The encoded tokens are already in the format VS Code uses, so no per-token conversion is needed.
+                        tokens = new vscode.SemanticTokens(decodeUint32Array(tokensResult.encodedTokens));
+                    } else {
+                        const builder: vscode.SemanticTokensBuilder = new vscode.SemanticTokensBuilder(this.client.semanticTokensLegend);
+                        tokensResult.tokens.forEach((token) => {
+                            builder.push(token.line, token.character, token.length, token.type, token.modifiers);
+                        });
+                        tokens = builder.build();
+                    }
                     this.tokenCaches.set(uriString, [tokensResult.fileVersion, tokens]);
                     return tokens;
                 }
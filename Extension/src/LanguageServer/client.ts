@@ -35,7 +35,11 @@ import minimatch = require("minimatch");
 import * as logger from '../logger';
 import { updateLanguageConfigurations, registerCommands } from './extension';
 import { SettingsTracker, getTracker } from './settingsTracker';
+import { SettingsSyncState, SettingsUpdate } from './settingsDelta';
+import { ModifiedLinesTracker } from './modifiedLinesTracker';
+import { invalidateFormatConfig, preloadDirectoryFormatConfigs } from './editorConfigCache';
 import { getTestHook, TestHook } from '../testHook';
+import { activationTracer } from '../activationTracer';
 import { getCustomConfigProviders, CustomConfigurationProvider1, isSameProviderExtensionId } from '../LanguageServer/customProviders';
 import * as fs from 'fs';
 import * as os from 'os';
@@ -52,6 +56,8 @@ let timeStamp: number = 0;
 const configProviderTimeout: number = 2000;
 
 // Data shared by all clients.
+// A single language server process hosts every workspace folder. Each DefaultClient is a per-folder
+// context on that process, identified by the workspaceFolderUri sent with its requests and notifications.
 let languageClient: LanguageClient;
 let languageClientCrashedNeedsRestart: boolean = false;
 const languageClientCrashTimes: number[] = [];
@@ -66,8 +72,6 @@ let diagnosticsCollection: vscode.DiagnosticCollection;
 let workspaceDisposables: vscode.Disposable[] = [];
 export let workspaceReferences: refs.ReferencesManager;
 export const openFileVersions: Map<string, number> = new Map<string, number>();
-export const cachedEditorConfigSettings: Map<string, any> = new Map<string, any>();
-export const cachedEditorConfigLookups: Map<string, boolean> = new Map<string, boolean>();
 
 export function disposeWorkspaceData(): void {
     workspaceDisposables.forEach((d) => d.dispose());
@@ -167,6 +171,7 @@ function publishDiagnostics(params: PublishDiagnosticsParams): void {
     diagnosticsCollection.set(realUri, diagnostics);
 
     clientCollection.timeTelemetryCollector.setUpdateRangeTime(realUri);
+    activationTracer.mark("firstDiagnostics");
 }
 
 interface WorkspaceFolderParams {
@@ -210,7 +215,7 @@ interface FileChangedParams extends WorkspaceFolderParams {
     uri: string;
 }
 
-interface InputRegion {
+export interface InputRegion {
     startLine: number;
     endLine: number;
 }
@@ -378,7 +383,12 @@ export interface CppFoldingRange {
 
 export interface GetFoldingRangesResult {
     canceled: boolean;
+    // The version of the file the ranges were computed for, if the language server reports it.
+    fileVersion?: number;
     ranges: CppFoldingRange[];
+    // If set, the ranges are sent in this field instead of `ranges`, as base64-encoded
+    // little-endian uint32 triples of (startLine, endLine, kind).
+    encodedRanges?: string;
 }
 
 interface AbortRequestParams {
@@ -402,6 +412,9 @@ export interface GetSemanticTokensResult {
     fileVersion: number;
     canceled: boolean;
     tokens: SemanticToken[];
+    // If set, the tokens are sent in this field instead of `tokens`, as base64-encoded little-endian
+    // uint32 data in the relative (delta-encoded) format used by vscode.SemanticTokens.
+    encodedTokens?: string;
 }
 
 enum SemanticTokenTypes {
@@ -683,6 +696,8 @@ export class DefaultClient implements Client {
     private isSupported: boolean = true;
     private inactiveRegionsDecorations = new Map<string, DecorationRangesPair>();
     private settingsTracker: SettingsTracker;
+    private settingsSyncState: SettingsSyncState = new SettingsSyncState();
+    public modifiedLinesTracker: ModifiedLinesTracker = new ModifiedLinesTracker();
     private loggingLevel: string | undefined;
     private configurationProvider?: string;
     private documentSelector: DocumentFilter[] = [
@@ -799,6 +814,7 @@ export class DefaultClient implements Client {
         this.settingsTracker = getTracker(rootUri);
         try {
             let firstClient: boolean = false;
+            let endLanguageServerStartSpan: (() => void) | undefined;
             if (!languageClient || languageClientCrashedNeedsRestart) {
                 if (languageClientCrashedNeedsRestart) {
                     languageClientCrashedNeedsRestart = false;
@@ -806,6 +822,7 @@ export class DefaultClient implements Client {
                 languageClient = this.createLanguageClient(allClients);
                 clientCollection = allClients;
                 languageClient.registerProposedFeatures();
+                endLanguageServerStartSpan = activationTracer.startSpan("languageServerStart");
                 languageClient.start();  // This returns Disposable, but doesn't need to be tracked because we call .stop() explicitly in our dispose()
                 util.setProgress(util.getProgressExecutableStarted());
                 firstClient = true;
@@ -816,6 +833,9 @@ export class DefaultClient implements Client {
             // requests/notifications are deferred until this.languageClient is set.
             this.queueBlockingTask(async () => {
                 await languageClient.onReady();
+                if (endLanguageServerStartSpan) {
+                    endLanguageServerStartSpan();
+                }
                 try {
                     const workspaceFolder: vscode.WorkspaceFolder | undefined = this.rootFolder;
                     this.innerConfiguration = new configs.CppProperties(rootUri, workspaceFolder);
@@ -907,12 +927,13 @@ export class DefaultClient implements Client {
 
                         // The configurations will not be sent to the language server until the default include paths and frameworks have been set.
                         // The event handlers must be set before this happens.
-                        const inputCompilerDefaults: configs.CompilerDefaults = await languageClient.sendRequest(QueryCompilerDefaultsRequest, {});
+                        const inputCompilerDefaults: configs.CompilerDefaults = await activationTracer.traceAsync("queryCompilerDefaults", () => languageClient.sendRequest(QueryCompilerDefaultsRequest, {}));
                         compilerDefaults = inputCompilerDefaults;
                         this.configuration.CompilerDefaults = compilerDefaults;
 
                         // Only register file watchers, providers, and the real commands after the extension has finished initializing,
                         // e.g. prevents empty c_cpp_properties.json from generation.
+                        const endRegistrationSpan: () => void = activationTracer.startSpan("registerCommandsAndProviders");
                         registerCommands();
 
                         this.registerFileWatcher();
@@ -938,6 +959,7 @@ export class DefaultClient implements Client {
                         }
                         // Listen for messages from the language server.
                         this.registerNotifications();
+                        endRegistrationSpan();
                     } else {
                         this.configuration.CompilerDefaults = compilerDefaults;
                     }
@@ -1314,6 +1336,8 @@ export class DefaultClient implements Client {
                 edgeMessagesDirectory: path.join(util.getExtensionFilePath("bin"), "messages", util.getLocaleId()),
                 localizedStrings: localizedStrings,
                 supportCuda: util.supportCuda,
+                supportEncodedSemanticTokens: true,
+                supportEncodedFoldingRanges: true,
                 packageVersion: util.packageJson.version
             },
             middleware: createProtocolFilter(allClients),
@@ -1402,7 +1426,14 @@ export class DefaultClient implements Client {
             }
         };
 
-        this.sendDidChangeSettings(settings);
+        this.notifyWhenLanguageClientReady(() => {
+            // Only the settings that changed since the last update are sent if the language server supports it.
+            const capabilities: any = this.languageClient.initializeResult?.capabilities;
+            const update: SettingsUpdate | undefined = this.settingsSyncState.getUpdate(settings, capabilities?.experimental?.settingsDelta === true);
+            if (update) {
+                this.languageClient.sendNotification(DidChangeSettingsNotification, { ...update, workspaceFolderUri: this.RootPath });
+            }
+        });
     }
 
     public sendDidChangeSettings(settings: any): void {
@@ -1412,8 +1443,14 @@ export class DefaultClient implements Client {
         });
     }
 
+    private affectsSentSettings(event: vscode.ConfigurationChangeEvent): boolean {
+        return ["C_Cpp", "files", "search", "editor.autoClosingBrackets"].some(section => event.affectsConfiguration(section, this.RootUri));
+    }
+
     public onDidChangeSettings(event: vscode.ConfigurationChangeEvent, isFirstClient: boolean): { [key: string]: string } {
-        this.sendAllSettings();
+        if (this.affectsSentSettings(event)) {
+            this.sendAllSettings();
+        }
         const changedSettings: { [key: string]: string } = this.settingsTracker.getChangedSettings();
         this.notifyWhenLanguageClientReady(() => {
             if (Object.keys(changedSettings).length > 0) {
@@ -1522,6 +1559,7 @@ export class DefaultClient implements Client {
                 if (oldVersion === undefined || newVersion > oldVersion) {
                     openFileVersions.set(textDocumentChangeEvent.document.uri.toString(), newVersion);
                 }
+                this.modifiedLinesTracker.onDidChangeTextDocument(textDocumentChangeEvent);
             }
         }
     }
@@ -1529,6 +1567,10 @@ export class DefaultClient implements Client {
     public onDidOpenTextDocument(document: vscode.TextDocument): void {
         if (document.uri.scheme === "file") {
             openFileVersions.set(document.uri.toString(), document.version);
+            // Read the formatting configuration files off the formatting path.
+            preloadDirectoryFormatConfigs(document.uri.fsPath).catch(() => {
+                // The files are read synchronously when they are needed instead.
+            });
         }
     }
 
@@ -1536,6 +1578,10 @@ export class DefaultClient implements Client {
         if (this.semanticTokensProvider) {
             this.semanticTokensProvider.invalidateFile(document.uri.toString());
         }
+        if (this.codeFoldingProvider) {
+            this.codeFoldingProvider.removeFile(document.uri.toString());
+        }
+        this.modifiedLinesTracker.removeFile(document.uri.toString());
         openFileVersions.delete(document.uri.toString());
     }
 
@@ -1735,7 +1781,7 @@ export class DefaultClient implements Client {
                             if (configurationLoggingStr.length === 0) {
                                 configurationLoggingStr += "Custom configurations:\n";
                             }
-                            configurationLoggingStr += `[ ${tuMatch[1]} ]\n${this.configurationLogging.get(tuPath)}\n`;
+                            configurationLoggingStr += `[ ${tuMatch[1]} ]\n${JSON.stringify(this.configurationLogging.get(tuPath), null, 4)}\n`;
                         }
                     }
                     tuSearchString = tuSearchString.substr(tuSearchIndex + 1);
@@ -2073,12 +2119,11 @@ export class DefaultClient implements Client {
             this.rootPathFileWatcher.onDidCreate(async (uri) => {
                 const fileName: string = path.basename(uri.fsPath).toLowerCase();
                 if (fileName === ".editorconfig") {
-                    cachedEditorConfigSettings.clear();
-                    cachedEditorConfigLookups.clear();
+                    invalidateFormatConfig(uri.fsPath);
                     await this.updateActiveDocumentTextOptions();
                 }
                 if (fileName === ".clang-format" || fileName === "_clang-format") {
-                    cachedEditorConfigLookups.clear();
+                    invalidateFormatConfig(uri.fsPath);
                 }
 
                 this.languageClient.sendNotification(FileCreatedNotification, { uri: uri.toString() });
@@ -2098,10 +2143,12 @@ export class DefaultClient implements Client {
                 const dotIndex: number = uri.fsPath.lastIndexOf('.');
                 const fileName: string = path.basename(uri.fsPath).toLowerCase();
                 if (fileName === ".editorconfig") {
-                    cachedEditorConfigSettings.clear();
-                    cachedEditorConfigLookups.clear();
+                    invalidateFormatConfig(uri.fsPath);
                     await this.updateActiveDocumentTextOptions();
                 }
+                if (fileName === ".clang-format" || fileName === "_clang-format") {
+                    invalidateFormatConfig(uri.fsPath);
+                }
                 if (dotIndex !== -1) {
                     const ext: string = uri.fsPath.substr(dotIndex + 1);
                     if (this.associations_for_did_change?.has(ext)) {
@@ -2119,12 +2166,8 @@ export class DefaultClient implements Client {
 
             this.rootPathFileWatcher.onDidDelete((uri) => {
                 const fileName: string = path.basename(uri.fsPath).toLowerCase();
-                if (fileName === ".editorconfig") {
-                    cachedEditorConfigSettings.clear();
-                    cachedEditorConfigLookups.clear();
-                }
-                if (fileName === ".clang-format" || fileName === "_clang-format") {
-                    cachedEditorConfigLookups.clear();
+                if (fileName === ".editorconfig" || fileName === ".clang-format" || fileName === "_clang-format") {
+                    invalidateFormatConfig(uri.fsPath);
                 }
                 this.languageClient.sendNotification(FileDeletedNotification, { uri: uri.toString() });
             });
@@ -2141,7 +2184,8 @@ export class DefaultClient implements Client {
 
     public addFileAssociations(fileAssociations: string, languageId: string): void {
         const settings: OtherSettings = new OtherSettings();
-        const assocs: any = settings.filesAssociations;
+        // Copy the associations, because the configuration snapshot they come from is shared.
+        const assocs: any = { ...settings.filesAssociations };
 
         const filesAndPaths: string[] = fileAssociations.split(";");
         let foundNewAssociation: boolean = false;
@@ -2199,12 +2243,8 @@ export class DefaultClient implements Client {
             const status: IntelliSenseStatus = { status: Status.IntelliSenseCompiling };
             testHook.updateStatus(status);
         } else if (message.endsWith("IntelliSense done")) {
-            const settings: CppSettings = new CppSettings();
-            if (settings.loggingLevel === "Debug") {
-                const out: logger.Logger = logger.getOutputChannelLogger();
-                const duration: number = Date.now() - timeStamp;
-                out.appendLine(localize("update.intellisense.time", "Update IntelliSense time (sec): {0}", duration / 1000));
-            }
+            const duration: number = Date.now() - timeStamp;
+            logger.getOutputChannelLogger().appendLineAtLevel(logger.LogLevel.Debug, () => localize("update.intellisense.time", "Update IntelliSense time (sec): {0}", duration / 1000));
             this.model.isUpdatingIntelliSense.Value = false;
             const status: IntelliSenseStatus = { status: Status.IntelliSenseReady };
             testHook.updateStatus(status);
@@ -2333,7 +2373,7 @@ export class DefaultClient implements Client {
             }
         }
         if (this.codeFoldingProvider) {
-            this.codeFoldingProvider.refresh();
+            this.codeFoldingProvider.updateInactiveRegions(params.uri, params.regions, params.fileVersion);
         }
     }
 
@@ -2585,16 +2625,17 @@ export class DefaultClient implements Client {
             return;
         }
 
-        const settings: CppSettings = new CppSettings();
         const out: logger.Logger = logger.getOutputChannelLogger();
-        if (settings.loggingLevel === "Debug") {
+        const isDebugLogging: boolean = logger.getLogLevel() >= logger.LogLevel.Debug;
+        if (isDebugLogging) {
             out.appendLine(localize("configurations.received", "Custom configurations received:"));
         }
         const sanitized: SourceFileConfigurationItemAdapter[] = [];
         configs.forEach(item => {
             if (this.isSourceFileConfigurationItem(item, providerVersion)) {
-                this.configurationLogging.set(item.uri.toString(), JSON.stringify(item.configuration, null, 4));
-                if (settings.loggingLevel === "Debug") {
+                // The configuration is only formatted if it is logged by the Log Diagnostics command.
+                this.configurationLogging.set(item.uri.toString(), { ...item.configuration });
+                if (isDebugLogging) {
                     out.appendLine(`  uri: ${item.uri.toString()}`);
                     out.appendLine(`  config: ${JSON.stringify(item.configuration, null, 2)}`);
                 }
@@ -2632,7 +2673,7 @@ export class DefaultClient implements Client {
     }
 
     private browseConfigurationLogging: string = "";
-    private configurationLogging: Map<string, string> = new Map<string, string>();
+    private configurationLogging: Map<string, SourceFileConfiguration> = new Map<string, SourceFileConfiguration>();
 
     private isWorkspaceBrowseConfiguration(input: any): boolean {
         return util.isArrayOfString(input.browsePath) &&
@@ -2682,11 +2723,8 @@ export class DefaultClient implements Client {
                 return;
             }
 
-            const settings: CppSettings = new CppSettings();
-            if (settings.loggingLevel === "Debug") {
-                const out: logger.Logger = logger.getOutputChannelLogger();
-                out.appendLine(localize("browse.configuration.received", "Custom browse configuration received: {0}", JSON.stringify(sanitized, null, 2)));
-            }
+            logger.getOutputChannelLogger().appendLineAtLevel(logger.LogLevel.Debug,
+                () => localize("browse.configuration.received", "Custom browse configuration received: {0}", JSON.stringify(sanitized, null, 2)));
 
             // Separate compiler path and args before sending to language client
             if (util.isString(sanitized.compilerPath)) {
@@ -2867,6 +2905,7 @@ export class DefaultClient implements Client {
     public dispose(): void {
         this.disposables.forEach((d) => d.dispose());
         this.disposables = [];
+        this.modifiedLinesTracker.dispose();
         if (this.documentFormattingProviderDisposable) {
             this.documentFormattingProviderDisposable.dispose();
             this.documentFormattingProviderDisposable = undefined;
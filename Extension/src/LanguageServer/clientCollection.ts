@@ -10,6 +10,7 @@ import * as cpptools from './client';
 import * as telemetry from '../telemetry';
 import { getCustomConfigProviders } from './customProviders';
 import { TimeTelemetryCollector } from './timeTelemetryCollector';
+import { WorkspaceFolderTrie, WorkspaceFolderEntry } from './workspaceFolderTrie';
 
 const defaultClientKey: string = "@@default@@";
 export interface ClientKey {
@@ -23,6 +24,7 @@ export class ClientCollection {
     private defaultClient: cpptools.Client;
     private activeClient: cpptools.Client;
     private activeDocument?: vscode.TextDocument;
+    private workspaceFolders: WorkspaceFolderTrie = new WorkspaceFolderTrie(vscode.workspace.workspaceFolders);
     public timeTelemetryCollector: TimeTelemetryCollector = new TimeTelemetryCollector();
 
     public get ActiveClient(): cpptools.Client { return this.activeClient; }
@@ -145,6 +147,7 @@ export class ClientCollection {
         }
 
         if (e !== undefined) {
+            this.workspaceFolders.reset(vscode.workspace.workspaceFolders);
             e.removed.forEach(folder => {
                 const path: string = util.asFolder(folder.uri);
                 const client: cpptools.Client | undefined = this.languageClients.get(path);
@@ -189,17 +192,16 @@ export class ClientCollection {
     }
 
     public getClientFor(uri: vscode.Uri): cpptools.Client {
-        const folder: vscode.WorkspaceFolder | undefined = uri ? vscode.workspace.getWorkspaceFolder(uri) : undefined;
-        if (!folder) {
+        const entry: WorkspaceFolderEntry | undefined = uri ? this.workspaceFolders.getFolder(uri) : undefined;
+        if (!entry) {
             return this.defaultClient;
         } else {
-            const key: string = util.asFolder(folder.uri);
-            const client: cpptools.Client | undefined = this.languageClients.get(key);
+            const client: cpptools.Client | undefined = this.languageClients.get(entry.key);
             if (client) {
                 return client;
             }
-            const newClient: cpptools.Client = cpptools.createClient(this, folder);
-            this.languageClients.set(key, newClient);
+            const newClient: cpptools.Client = cpptools.createClient(this, entry.folder);
+            this.languageClients.set(entry.key, newClient);
             getCustomConfigProviders().forEach(provider => newClient.onRegisterCustomConfigurationProvider(provider));
             const defaultClient: cpptools.DefaultClient = <cpptools.DefaultClient>newClient;
             defaultClient.sendAllSettings();
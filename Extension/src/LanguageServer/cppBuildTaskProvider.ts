@@ -103,18 +103,7 @@ export class CppBuildTaskProvider implements TaskProvider {
 
         // Get user compiler path.
         const userCompilerPathAndArgs: util.CompilerPathAndArgs | undefined = await activeClient.getCurrentCompilerPathAndArgs();
-        let userCompilerPath: string | undefined;
-        if (userCompilerPathAndArgs) {
-            userCompilerPath = userCompilerPathAndArgs.compilerPath;
-            if (userCompilerPath && userCompilerPathAndArgs.compilerName) {
-                userCompilerPath = userCompilerPath.trim();
-                if (isWindows && userCompilerPath.startsWith("/")) { // TODO: Add WSL compiler support.
-                    userCompilerPath = undefined;
-                } else {
-                    userCompilerPath = userCompilerPath.replace(/\\\\/g, "\\");
-                }
-            }
-        }
+        const userCompilerPath: string | undefined = this.getUserCompilerPath(userCompilerPathAndArgs);
 
         const isCompilerValid: boolean = userCompilerPath ? await util.checkFileExists(userCompilerPath) : false;
 
@@ -153,6 +142,43 @@ export class CppBuildTaskProvider implements TaskProvider {
         return result;
     }
 
+    private getUserCompilerPath(userCompilerPathAndArgs: util.CompilerPathAndArgs | undefined): string | undefined {
+        let userCompilerPath: string | undefined;
+        if (userCompilerPathAndArgs) {
+            userCompilerPath = userCompilerPathAndArgs.compilerPath;
+            if (userCompilerPath && userCompilerPathAndArgs.compilerName) {
+                userCompilerPath = userCompilerPath.trim();
+                if (os.platform() === 'win32' && userCompilerPath.startsWith("/")) { // TODO: Add WSL compiler support.
+                    userCompilerPath = undefined;
+                } else {
+                    userCompilerPath = userCompilerPath.replace(/\\\\/g, "\\");
+                }
+            }
+        }
+        return userCompilerPath;
+    }
+
+    // Identifies what getTasks depends on: the active file's extension, the compilers that can build it and whether
+    // the user's compiler exists. Returns undefined if there is no active file or language client.
+    // This waits for the language client's task queue, but doesn't send any requests to the language server.
+    public async getTasksKey(): Promise<string | undefined> {
+        const editor: TextEditor | undefined = window.activeTextEditor;
+        if (!editor) {
+            return undefined;
+        }
+        let activeClient: Client;
+        try {
+            activeClient = ext.getActiveClient();
+        } catch (e) {
+            return undefined;
+        }
+        const userCompilerPathAndArgs: util.CompilerPathAndArgs | undefined = await activeClient.getCurrentCompilerPathAndArgs();
+        const userCompilerPath: string | undefined = this.getUserCompilerPath(userCompilerPathAndArgs);
+        const isCompilerValid: boolean = userCompilerPath ? await util.checkFileExists(userCompilerPath) : false;
+        const knownCompilers: configs.KnownCompiler[] | undefined = await activeClient.getKnownCompilers();
+        return JSON.stringify([path.extname(editor.document.fileName), userCompilerPathAndArgs, isCompilerValid, knownCompilers]);
+    }
+
     private getTask: (compilerPath: string, appendSourceToName: boolean, compilerArgs?: string[], definition?: CppBuildTaskDefinition, detail?: string) => Task = (compilerPath: string, appendSourceToName: boolean, compilerArgs?: string[], definition?: CppBuildTaskDefinition, detail?: string) => {
         const compilerPathBase: string = path.basename(compilerPath);
         const isCl: boolean = compilerPathBase.toLowerCase() === "cl.exe";
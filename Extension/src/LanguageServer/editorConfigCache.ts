@@ -0,0 +1,157 @@
+/* --------------------------------------------------------------------------------------------
+ * Copyright (c) Microsoft Corporation. All Rights Reserved.
+ * See 'LICENSE' in the project root for license information.
+ * ------------------------------------------------------------------------------------------ */
+'use strict';
+
+import * as fs from 'fs';
+import * as path from 'path';
+import * as editorConfig from 'editorconfig';
+
+/**
+ * The formatting configuration files found in a single directory.
+ */
+export interface DirectoryFormatConfig {
+    // The contents of the directory's .editorconfig file, if it has one.
+    editorConfigContents?: string;
+    // True if the .editorconfig file contains `root = true`.
+    editorConfigIsRoot: boolean;
+    // True if the directory has a .clang-format or _clang-format file.
+    hasClangFormat: boolean;
+}
+
+// Formatting configuration files, keyed by directory path.
+const directoryConfigs: Map<string, DirectoryFormatConfig> = new Map<string, DirectoryFormatConfig>();
+// Incremented when a formatting configuration file changes, so that a preload that read the files before the
+// change doesn't cache their old contents.
+let invalidationCount: number = 0;
+
+// Resolved .editorconfig settings, keyed by file path.
+export const cachedEditorConfigSettings: Map<string, any> = new Map<string, any>();
+// Whether vcFormat settings from an .editorconfig apply to a file, keyed by file path.
+export const cachedEditorConfigLookups: Map<string, boolean> = new Map<string, boolean>();
+
+const editorConfigRootRegex: RegExp = /^\s*root\s*=\s*true\s*$/im;
+
+function makeDirectoryConfig(editorConfigContents: string | undefined, hasClangFormat: boolean): DirectoryFormatConfig {
+    return {
+        editorConfigContents: editorConfigContents,
+        editorConfigIsRoot: editorConfigContents !== undefined && editorConfigRootRegex.test(editorConfigContents),
+        hasClangFormat: hasClangFormat
+    };
+}
+
+function readFileIfExists(filePath: string): string | undefined {
+    try {
+        return fs.readFileSync(filePath, "utf8");
+    } catch (e) {
+        return undefined;
+    }
+}
+
+async function readFileIfExistsAsync(filePath: string): Promise<string | undefined> {
+    try {
+        return await fs.promises.readFile(filePath, "utf8");
+    } catch (e) {
+        return undefined;
+    }
+}
+
+async function existsAsync(filePath: string): Promise<boolean> {
+    try {
+        await fs.promises.access(filePath);
+        return true;
+    } catch (e) {
+        return false;
+    }
+}
+
+// Returns the formatting configuration files of a directory, reading them only if the directory is not cached.
+// This is intentionally not async to avoid races due to multiple entrancy.
+export function getDirectoryFormatConfig(dirPath: string): DirectoryFormatConfig {
+    let config: DirectoryFormatConfig | undefined = directoryConfigs.get(dirPath);
+    if (!config) {
+        const editorConfigContents: string | undefined = readFileIfExists(path.join(dirPath, ".editorconfig"));
+        const hasClangFormat: boolean = editorConfigContents === undefined
+            && (fs.existsSync(path.join(dirPath, ".clang-format")) || fs.existsSync(path.join(dirPath, "_clang-format")));
+        config = makeDirectoryConfig(editorConfigContents, hasClangFormat);
+        directoryConfigs.set(dirPath, config);
+    }
+    return config;
+}
+
+// Asynchronously reads the formatting configuration files of all uncached ancestor directories of a file,
+// so that later synchronous lookups for that file (e.g. when formatting) do not need to access the disk.
+export async function preloadDirectoryFormatConfigs(fsPath: string): Promise<void> {
+    let parentPath: string = path.dirname(fsPath);
+    let currentParentPath: string;
+    do {
+        currentParentPath = parentPath;
+        let config: DirectoryFormatConfig | undefined = directoryConfigs.get(currentParentPath);
+        if (!config) {
+            const startInvalidationCount: number = invalidationCount;
+            const editorConfigContents: string | undefined = await readFileIfExistsAsync(path.join(currentParentPath, ".editorconfig"));
+            const hasClangFormat: boolean = editorConfigContents === undefined
+                && (await existsAsync(path.join(currentParentPath, ".clang-format")) || await existsAsync(path.join(currentParentPath, "_clang-format")));
+            if (invalidationCount !== startInvalidationCount) {
+                // The files may have changed after they were read. Leave them to be read when they are needed.
+                return;
+            }
+            // A synchronous lookup may have populated the entry while the files were being read.
+            config = directoryConfigs.get(currentParentPath);
+            if (!config) {
+                config = makeDirectoryConfig(editorConfigContents, hasClangFormat);
+                directoryConfigs.set(currentParentPath, config);
+            }
+        }
+        if (config.editorConfigIsRoot) {
+            break;
+        }
+        parentPath = path.dirname(parentPath);
+    } while (parentPath !== currentParentPath);
+}
+
+// Look up the appropriate .editorconfig settings for the specified file, using the cached .editorconfig
+// files of its ancestor directories.
+export function resolveEditorConfigSettings(fsPath: string): any {
+    const files: { name: string; contents: string }[] = [];
+    let parentPath: string = path.dirname(fsPath);
+    let currentParentPath: string;
+    do {
+        currentParentPath = parentPath;
+        const config: DirectoryFormatConfig = getDirectoryFormatConfig(currentParentPath);
+        if (config.editorConfigContents !== undefined) {
+            // Ordered from the closest file to the root.
+            files.push({ name: path.join(currentParentPath, ".editorconfig"), contents: config.editorConfigContents });
+            if (config.editorConfigIsRoot) {
+                break;
+            }
+        }
+        parentPath = path.dirname(parentPath);
+    } while (parentPath !== currentParentPath);
+    return editorConfig.parseFromFilesSync(fsPath, files);
+}
+
+function isInDirectory(dirPath: string, fsPath: string): boolean {
+    return fsPath.startsWith(dirPath) && (fsPath.length === dirPath.length || fsPath[dirPath.length] === path.sep || dirPath.endsWith(path.sep));
+}
+
+function deleteEntriesInDirectory<T>(map: Map<string, T>, dirPath: string): void {
+    for (const key of map.keys()) {
+        if (isInDirectory(dirPath, key)) {
+            map.delete(key);
+        }
+    }
+}
+
+// Called when an .editorconfig, .clang-format or _clang-format file is created, changed or deleted.
+// Only the cached results for files under the directory containing the changed file are invalidated.
+export function invalidateFormatConfig(configFilePath: string): void {
+    const dirPath: string = path.dirname(configFilePath);
+    ++invalidationCount;
+    directoryConfigs.delete(dirPath);
+    deleteEntriesInDirectory(cachedEditorConfigLookups, dirPath);
+    if (path.basename(configFilePath).toLowerCase() === ".editorconfig") {
+        deleteEntriesInDirectory(cachedEditorConfigSettings, dirPath);
+    }
+}
@@ -31,6 +31,7 @@ import * as nls from 'vscode-nls';
 import { CppBuildTaskProvider } from './cppBuildTaskProvider';
 import * as which from 'which';
 import { IExperimentationService } from 'tas-client';
+import { activationTracer } from '../activationTracer';
 
 nls.config({ messageFormat: nls.MessageFormat.bundle, bundleFormat: nls.BundleFormat.standalone })();
 const localize: nls.LocalizeFunc = nls.loadMessageBundle();
@@ -42,6 +43,7 @@ let activeDocument: string;
 let ui: UI;
 const disposables: vscode.Disposable[] = [];
 let languageConfigurations: vscode.Disposable[] = [];
+let appliedLanguageConfigurations: vscode.LanguageConfiguration[] = [];
 let intervalTimer: NodeJS.Timer;
 let insiderUpdateEnabled: boolean = false;
 let insiderUpdateTimer: NodeJS.Timer;
@@ -56,7 +58,17 @@ let codeActionProvider: vscode.Disposable;
 export const intelliSenseDisabledError: string = "Do not activate the extension when IntelliSense is disabled.";
 
 type VcpkgDatabase = { [key: string]: string[] }; // Stored as <header file entry> -> [<port name>]
-let vcpkgDbPromise: Promise<VcpkgDatabase>;
+let vcpkgDbPromise: Promise<VcpkgDatabase> | undefined;
+
+// The database is only used by the vcpkg code actions, so it is loaded when they first need it
+// rather than during activation.
+function getVcpkgDatabase(): Promise<VcpkgDatabase> {
+    if (!vcpkgDbPromise) {
+        vcpkgDbPromise = activationTracer.traceAsync("initVcpkgDatabase", () => initVcpkgDatabase(), "lazy");
+    }
+    return vcpkgDbPromise;
+}
+
 function initVcpkgDatabase(): Promise<VcpkgDatabase> {
     return new Promise((resolve, reject) => {
         yauzl.open(util.getExtensionFilePath('VCPkgHeadersDatabase.zip'), { lazyEntries: true }, (err?: Error, zipfile?: yauzl.ZipFile) => {
@@ -133,7 +145,7 @@ async function lookupIncludeInVcpkg(document: vscode.TextDocument, line: number)
     const missingHeader: string = matches.groups['includeFile'].replace(/\//g, '\\');
 
     let portsWithHeader: string[] | undefined;
-    const vcpkgDb: VcpkgDatabase = await vcpkgDbPromise;
+    const vcpkgDb: VcpkgDatabase = await getVcpkgDatabase();
     if (vcpkgDb) {
         portsWithHeader = vcpkgDb[missingHeader];
     }
@@ -169,6 +181,7 @@ export async function activate(activationEventOccurred: boolean): Promise<void>
     }
 
     // handle "workspaceContains:/.vscode/c_cpp_properties.json" activation event.
+    const endPropertiesCheckSpan: () => void = activationTracer.startSpan("checkCppPropertiesExists");
     let cppPropertiesExists: boolean = false;
     if (vscode.workspace.workspaceFolders && vscode.workspace.workspaceFolders.length > 0) {
         for (let i: number = 0; i < vscode.workspace.workspaceFolders.length; ++i) {
@@ -180,6 +193,7 @@ export async function activate(activationEventOccurred: boolean): Promise<void>
             }
         }
     }
+    endPropertiesCheckSpan();
 
     // Check if an activation event has already occurred.
     if (activationEventOccurred) {
@@ -284,6 +298,7 @@ function sendActivationTelemetry(): void {
 }
 
 function realActivation(): void {
+    const endRealActivationSpan: () => void = activationTracer.startSpan("realActivation");
     if (new CppSettings(vscode.workspace.workspaceFolders ? vscode.workspace.workspaceFolders[0].uri : undefined).intelliSenseEngine === "Disabled") {
         throw new Error(intelliSenseDisabledError);
     } else {
@@ -302,7 +317,7 @@ function realActivation(): void {
 
     realActivationOccurred = true;
     console.log("starting language server");
-    clients = new ClientCollection();
+    clients = activationTracer.trace("ClientCollection", () => new ClientCollection());
     ui = getUI();
 
     // Log cold start.
@@ -323,19 +338,17 @@ function realActivation(): void {
     disposables.push(vscode.window.onDidChangeTextEditorSelection(onDidChangeTextEditorSelection));
     disposables.push(vscode.window.onDidChangeVisibleTextEditors(onDidChangeVisibleTextEditors));
 
-    updateLanguageConfigurations();
+    activationTracer.trace("updateLanguageConfigurations", () => updateLanguageConfigurations());
 
     reportMacCrashes();
 
     const settings: CppSettings = new CppSettings();
 
-    vcpkgDbPromise = initVcpkgDatabase();
-
     PlatformInformation.GetPlatformInformation().then(async info => {
         // Skip Insiders processing for 32-bit Linux.
         if (info.platform !== "linux" || info.architecture === "x64" || info.architecture === "arm" || info.architecture === "arm64") {
             // Skip Insiders processing for unsupported VS Code versions.
-            const experimentationService: IExperimentationService | undefined = await telemetry.getExperimentationService();
+            const experimentationService: IExperimentationService | undefined = await activationTracer.traceAsync("getExperimentationService", () => telemetry.getExperimentationService());
             // If we can't get to the experimentation service, don't suggest Insiders.
             if (experimentationService !== undefined) {
                 const allowInsiders: boolean | undefined = await experimentationService.getTreatmentVariableAsync<boolean>("vscode", "allowInsiders");
@@ -360,15 +373,22 @@ function realActivation(): void {
     clients.ActiveClient.notifyWhenLanguageClientReady(() => {
         intervalTimer = global.setInterval(onInterval, 2500);
     });
+    endRealActivationSpan();
 }
 
 export function updateLanguageConfigurations(): void {
+    const configs: vscode.LanguageConfiguration[] = [getLanguageConfig('c'), getLanguageConfig('cpp'), getLanguageConfig('cuda-cpp')];
+    // The compiled configurations are cached, so they are the same objects if the patterns did not change.
+    if (languageConfigurations.length > 0 && configs.every((config, index) => config === appliedLanguageConfigurations[index])) {
+        return;
+    }
     languageConfigurations.forEach(d => d.dispose());
     languageConfigurations = [];
+    appliedLanguageConfigurations = configs;
 
-    languageConfigurations.push(vscode.languages.setLanguageConfiguration('c', getLanguageConfig('c')));
-    languageConfigurations.push(vscode.languages.setLanguageConfiguration('cpp', getLanguageConfig('cpp')));
-    languageConfigurations.push(vscode.languages.setLanguageConfiguration('cuda-cpp', getLanguageConfig('cuda-cpp')));
+    languageConfigurations.push(vscode.languages.setLanguageConfiguration('c', configs[0]));
+    languageConfigurations.push(vscode.languages.setLanguageConfiguration('cpp', configs[1]));
+    languageConfigurations.push(vscode.languages.setLanguageConfiguration('cuda-cpp', configs[2]));
 }
 
 /**
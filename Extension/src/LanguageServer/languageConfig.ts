@@ -6,9 +6,10 @@
 
 import * as vscode from 'vscode';
 import { CppSettings } from './settings';
-import { getOutputChannel } from '../logger';
+import { getOutputChannel, getOutputChannelLogger, LogLevel } from '../logger';
 import * as nls from 'vscode-nls';
 import { isString } from '../common';
+import { performance } from 'perf_hooks';
 
 nls.config({ messageFormat: nls.MessageFormat.bundle, bundleFormat: nls.BundleFormat.standalone })();
 const localize: nls.LocalizeFunc = nls.loadMessageBundle();
@@ -237,7 +238,24 @@ export function getLanguageConfig(languageId: string): vscode.LanguageConfigurat
     return getLanguageConfigFromPatterns(languageId, patterns);
 }
 
+// Compiled language configurations, keyed by language ID and comment continuation patterns.
+// The rules only depend on these, so unchanged patterns are never recompiled.
+const compiledLanguageConfigs: Map<string, vscode.LanguageConfiguration> = new Map<string, vscode.LanguageConfiguration>();
+
 export function getLanguageConfigFromPatterns(languageId: string, patterns?: (string | CommentPattern)[]): vscode.LanguageConfiguration {
+    const key: string = languageId + "|" + JSON.stringify(patterns ?? null);
+    let config: vscode.LanguageConfiguration | undefined = compiledLanguageConfigs.get(key);
+    if (!config) {
+        const start: number = performance.now();
+        config = compileLanguageConfig(languageId, patterns);
+        const elapsed: number = performance.now() - start;
+        compiledLanguageConfigs.set(key, config);
+        getOutputChannelLogger().appendLineAtLevel(LogLevel.Debug, () => `Compiled ${config?.onEnterRules?.length ?? 0} onEnter rules for ${languageId} in ${elapsed.toFixed(2)} ms.`);
+    }
+    return config;
+}
+
+function compileLanguageConfig(languageId: string, patterns?: (string | CommentPattern)[]): vscode.LanguageConfiguration {
     const beginPatterns: string[] = [];       // avoid duplicate rules
     const continuePatterns: string[] = [];    // avoid duplicate rules
     let duplicates: boolean = false;
@@ -0,0 +1,110 @@
+/* --------------------------------------------------------------------------------------------
+ * Copyright (c) Microsoft Corporation. All Rights Reserved.
+ * See 'LICENSE' in the project root for license information.
+ * ------------------------------------------------------------------------------------------ */
+'use strict';
+
+import * as vscode from 'vscode';
+
+/**
+ * An inclusive range of line numbers.
+ */
+export interface LineRange {
+    startLine: number;
+    endLine: number;
+}
+
+/**
+ * Tracks which lines of each open document were modified since it was last saved,
+ * so formatting can be limited to those lines.
+ */
+export class ModifiedLinesTracker implements vscode.Disposable {
+    // Sorted, non-overlapping modified line ranges, keyed by document URI.
+    private modifiedLines: Map<string, LineRange[]> = new Map<string, LineRange[]>();
+    // Documents that were already dirty when they were opened, whose modifications are not known until they are saved.
+    private untracked: Set<string> = new Set<string>();
+    private disposables: vscode.Disposable[] = [];
+
+    constructor() {
+        vscode.workspace.textDocuments.forEach(doc => this.onDidOpenTextDocument(doc));
+        this.disposables.push(vscode.workspace.onDidOpenTextDocument(doc => this.onDidOpenTextDocument(doc)));
+        this.disposables.push(vscode.workspace.onDidSaveTextDocument(doc => {
+            this.modifiedLines.delete(doc.uri.toString());
+            this.untracked.delete(doc.uri.toString());
+        }));
+    }
+
+    /**
+     * Returns the modified line ranges of a document, or undefined if the document's
+     * modifications are not known (e.g. it was already dirty when it was opened).
+     */
+    public getModifiedLines(document: vscode.TextDocument): LineRange[] | undefined {
+        if (!document.isDirty || this.untracked.has(document.uri.toString())) {
+            return undefined;
+        }
+        return this.modifiedLines.get(document.uri.toString());
+    }
+
+    public onDidChangeTextDocument(event: vscode.TextDocumentChangeEvent): void {
+        if (event.contentChanges.length === 0) {
+            return;
+        }
+        const uri: string = event.document.uri.toString();
+        let ranges: LineRange[] = this.modifiedLines.get(uri) ?? [];
+        // Changes in a single event are relative to the document before the event. Applying them from the
+        // bottom of the document up ensures each change only shifts ranges that have already been adjusted.
+        const changes: vscode.TextDocumentContentChangeEvent[] = [...event.contentChanges].sort((a, b) => b.range.start.compareTo(a.range.start));
+        for (const change of changes) {
+            ranges = ModifiedLinesTracker.applyChange(ranges, change);
+        }
+        this.modifiedLines.set(uri, ranges);
+    }
+
+    public removeFile(uri: string): void {
+        this.modifiedLines.delete(uri);
+        this.untracked.delete(uri);
+    }
+
+    public dispose(): void {
+        this.disposables.forEach((d) => d.dispose());
+        this.disposables = [];
+        this.modifiedLines.clear();
+        this.untracked.clear();
+    }
+
+    private onDidOpenTextDocument(document: vscode.TextDocument): void {
+        if (document.isDirty) {
+            this.untracked.add(document.uri.toString());
+        }
+    }
+
+    private static applyChange(ranges: LineRange[], change: vscode.TextDocumentContentChangeEvent): LineRange[] {
+        let addedLines: number = 0;
+        for (let i: number = change.text.indexOf("\n"); i !== -1; i = change.text.indexOf("\n", i + 1)) {
+            addedLines++;
+        }
+        const delta: number = addedLines - (change.range.end.line - change.range.start.line);
+        const changed: LineRange = { startLine: change.range.start.line, endLine: change.range.start.line + addedLines };
+        const result: LineRange[] = [];
+        let inserted: boolean = false;
+        for (const range of ranges) {
+            if (range.endLine < changed.startLine - 1) {
+                result.push(range);
+            } else if (range.startLine > change.range.end.line + 1) {
+                if (!inserted) {
+                    result.push(changed);
+                    inserted = true;
+                }
+                result.push({ startLine: range.startLine + delta, endLine: range.endLine + delta });
+            } else {
+                // Overlapping or adjacent ranges are merged into the changed range.
+                changed.startLine = Math.min(changed.startLine, range.startLine);
+                changed.endLine = Math.max(changed.endLine, range.endLine + delta);
+            }
+        }
+        if (!inserted) {
+            result.push(changed);
+        }
+        return result;
+    }
+}
@@ -5,6 +5,7 @@
 'use strict';
 import * as vscode from 'vscode';
 import { ReferenceType, ReferenceInfo, ReferencesResult } from './references';
+import { uriInternTable, makeVscodeLineRange } from './Providers/internTable';
 
 export class ReferencesModel {
     readonly nodes: TreeNode[] = []; // Raw flat list of references
@@ -24,13 +25,13 @@ export class ReferencesModel {
             const noReferenceLocation: boolean = (r.position.line === 0 && r.position.character === 0);
             if (noReferenceLocation) {
                 const node: TreeNode = new TreeNode(this, NodeType.fileWithPendingRef);
-                node.fileUri = vscode.Uri.file(r.file);
+                node.fileUri = uriInternTable.file(r.file);
                 node.filename = r.file;
                 node.referenceType = r.type;
                 this.nodes.push(node);
             } else {
-                const range: vscode.Range = new vscode.Range(r.position.line, r.position.character, r.position.line, r.position.character + this.originalSymbol.length);
-                const uri: vscode.Uri = vscode.Uri.file(r.file);
+                const range: vscode.Range = makeVscodeLineRange(r.position.line, r.position.character, this.originalSymbol.length);
+                const uri: vscode.Uri = uriInternTable.file(r.file);
                 const location: vscode.Location = new vscode.Location(uri, range);
                 const node: TreeNode = new TreeNode(this, NodeType.reference);
                 node.fileUri = uri;
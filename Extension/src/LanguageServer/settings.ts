@@ -11,10 +11,8 @@ import * as os from 'os';
 import * as which from 'which';
 import { execSync } from 'child_process';
 import * as semver from 'semver';
-import * as fs from 'fs';
 import * as path from 'path';
-import { cachedEditorConfigLookups, cachedEditorConfigSettings } from './client';
-import * as editorConfig from 'editorconfig';
+import { cachedEditorConfigLookups, cachedEditorConfigSettings, getDirectoryFormatConfig, DirectoryFormatConfig, resolveEditorConfigSettings } from './editorConfigCache';
 import { PersistentState } from './persistentState';
 import * as nls from 'vscode-nls';
 
@@ -25,6 +23,32 @@ function getTarget(): vscode.ConfigurationTarget {
     return (vscode.workspace.workspaceFolders) ? vscode.ConfigurationTarget.WorkspaceFolder : vscode.ConfigurationTarget.Global;
 }
 
+// vscode.WorkspaceConfiguration objects are snapshots that do not change, so they are reused until the
+// configuration changes. Settings of files in the same workspace folder are the same, so they share a snapshot
+// of the folder's settings. The listener is registered when this module is loaded, before any other
+// onDidChangeConfiguration listener of the extension, so those listeners never see a stale snapshot.
+// It is disposed when the extension is deactivated.
+const maxCachedConfigurations: number = 1000;
+const cachedConfigurations: Map<string, vscode.WorkspaceConfiguration> = new Map<string, vscode.WorkspaceConfiguration>();
+export const configurationCacheListener: vscode.Disposable = vscode.workspace.onDidChangeConfiguration(() => cachedConfigurations.clear());
+
+export function getCachedConfiguration(section: string, resource?: vscode.Uri, languageId?: string): vscode.WorkspaceConfiguration {
+    // Files outside of the workspace folders get the workspace's settings.
+    const folder: vscode.WorkspaceFolder | undefined = resource ? vscode.workspace.getWorkspaceFolder(resource) : undefined;
+    const scope: vscode.Uri | undefined = folder ? folder.uri : undefined;
+    const key: string = `${section}|${scope ? scope.toString() : ""}|${languageId ?? ""}`;
+    let configuration: vscode.WorkspaceConfiguration | undefined = cachedConfigurations.get(key);
+    if (!configuration) {
+        configuration = languageId ? vscode.workspace.getConfiguration(section, { uri: scope, languageId: languageId })
+            : vscode.workspace.getConfiguration(section, scope ? scope : null);
+        if (cachedConfigurations.size >= maxCachedConfigurations) {
+            cachedConfigurations.clear();
+        }
+        cachedConfigurations.set(key, configuration);
+    }
+    return configuration;
+}
+
 class Settings {
     private readonly settings: vscode.WorkspaceConfiguration;
 
@@ -33,7 +57,7 @@ class Settings {
      * @param resource The path to a resource to which the settings should apply, or null if global settings are desired
      */
     constructor(section: string, public resource?: vscode.Uri) {
-        this.settings = vscode.workspace.getConfiguration(section, resource ? resource : null);
+        this.settings = getCachedConfiguration(section, resource);
     }
 
     protected get Section(): vscode.WorkspaceConfiguration { return this.settings; }
@@ -167,18 +191,24 @@ export class CppSettings extends Settings {
     public get defaultEnableConfigurationSquiggles(): boolean | undefined { return super.Section.get<boolean>("default.enableConfigurationSquiggles"); }
     public get defaultCustomConfigurationVariables(): { [key: string]: string } | undefined { return super.Section.get<{ [key: string]: string }>("default.customConfigurationVariables"); }
     public get useBacktickCommandSubstitution(): boolean | undefined { return super.Section.get<boolean>("debugger.useBacktickCommandSubstitution"); }
+    public get prewarmDebugAdapter(): boolean | undefined { return super.Section.get<boolean>("debugger.prewarmDebugAdapter"); }
+    public get compoundLaunchParallelism(): number | undefined { return super.Section.get<number>("debugger.compoundLaunchParallelism"); }
     public get codeFolding(): boolean { return super.Section.get<string>("codeFolding") === "Enabled"; }
 
     public get enhancedColorization(): boolean {
         return super.Section.get<string>("enhancedColorization") === "Enabled"
             && super.Section.get<string>("intelliSenseEngine") === "Default"
-            && vscode.workspace.getConfiguration("workbench").get<string>("colorTheme") !== "Default High Contrast";
+            && getCachedConfiguration("workbench").get<string>("colorTheme") !== "Default High Contrast";
     }
 
     public get formattingEngine(): string | undefined {
         return super.Section.get<string>("formatting");
     }
 
+    public get formatModifiedLinesOnly(): boolean {
+        return super.Section.get<boolean>("formatModifiedLinesOnly") === true;
+    }
+
     public get vcFormatIndentBraces(): boolean {
         return super.Section.get<boolean>("vcFormat.indent.braces") === true;
     }
@@ -444,7 +474,7 @@ export class CppSettings extends Settings {
     public get dimInactiveRegions(): boolean {
         return super.Section.get<boolean>("dimInactiveRegions") === true
             && super.Section.get<string>("intelliSenseEngine") === "Default"
-            && vscode.workspace.getConfiguration("workbench").get<string>("colorTheme") !== "Default High Contrast";
+            && getCachedConfiguration("workbench").get<string>("colorTheme") !== "Default High Contrast";
     }
 
     public toggleSetting(name: string, value1: string, value2: string): void {
@@ -626,8 +656,8 @@ export class CppSettings extends Settings {
         }
         let foundEditorConfigWithVcFormatSettings: boolean = false;
         const findConfigFile: (parentPath: string) => boolean = (parentPath: string) => {
-            const editorConfigPath: string = path.join(parentPath, ".editorconfig");
-            if (fs.existsSync(editorConfigPath)) {
+            const directoryConfig: DirectoryFormatConfig = getDirectoryFormatConfig(parentPath);
+            if (directoryConfig.editorConfigContents !== undefined) {
                 const editorConfigSettings: any = getEditorConfigSettings(document.uri.fsPath);
                 const keys: string[] = Object.keys(editorConfigSettings);
                 for (let i: number = 0; i < keys.length; ++i) {
@@ -645,16 +675,8 @@ export class CppSettings extends Settings {
                 if (editorConfigSettings.root?.toLowerCase() === "true") {
                     return true;
                 }
-            } else {
-                const clangFormatPath1: string = path.join(parentPath, ".clang-format");
-                if (fs.existsSync(clangFormatPath1)) {
-                    return true;
-                } else {
-                    const clangFormatPath2: string = path.join(parentPath, "_clang-format");
-                    if (fs.existsSync(clangFormatPath2)) {
-                        return true;
-                    }
-                }
+            } else if (directoryConfig.hasClangFormat) {
+                return true;
             }
             return false;
         };
@@ -696,24 +718,24 @@ export class OtherSettings {
         this.resource = resource;
     }
 
-    public get editorTabSize(): number | undefined { return vscode.workspace.getConfiguration("editor", this.resource).get<number>("tabSize"); }
-    public get editorAutoClosingBrackets(): string | undefined { return vscode.workspace.getConfiguration("editor", this.resource).get<string>("autoClosingBrackets"); }
-    public get filesEncoding(): string | undefined { return vscode.workspace.getConfiguration("files", { uri: this.resource, languageId: "cpp" }).get<string>("encoding"); }
-    public get filesAssociations(): any { return vscode.workspace.getConfiguration("files").get("associations"); }
+    public get editorTabSize(): number | undefined { return getCachedConfiguration("editor", this.resource).get<number>("tabSize"); }
+    public get editorAutoClosingBrackets(): string | undefined { return getCachedConfiguration("editor", this.resource).get<string>("autoClosingBrackets"); }
+    public get filesEncoding(): string | undefined { return getCachedConfiguration("files", this.resource, "cpp").get<string>("encoding"); }
+    public get filesAssociations(): any { return getCachedConfiguration("files").get("associations"); }
     public set filesAssociations(value: any) {
         vscode.workspace.getConfiguration("files").update("associations", value, vscode.ConfigurationTarget.Workspace);
     }
-    public get filesExclude(): vscode.WorkspaceConfiguration | undefined { return vscode.workspace.getConfiguration("files", this.resource).get("exclude"); }
-    public get searchExclude(): vscode.WorkspaceConfiguration | undefined { return vscode.workspace.getConfiguration("search", this.resource).get("exclude"); }
-    public get settingsEditor(): string | undefined { return vscode.workspace.getConfiguration("workbench.settings").get<string>("editor"); }
+    public get filesExclude(): vscode.WorkspaceConfiguration | undefined { return getCachedConfiguration("files", this.resource).get("exclude"); }
+    public get searchExclude(): vscode.WorkspaceConfiguration | undefined { return getCachedConfiguration("search", this.resource).get("exclude"); }
+    public get settingsEditor(): string | undefined { return getCachedConfiguration("workbench.settings").get<string>("editor"); }
 
-    public get colorTheme(): string | undefined { return vscode.workspace.getConfiguration("workbench").get<string>("colorTheme"); }
+    public get colorTheme(): string | undefined { return getCachedConfiguration("workbench").get<string>("colorTheme"); }
 
-    public getCustomColorToken(colorTokenName: string): string | undefined { return vscode.workspace.getConfiguration("editor.tokenColorCustomizations").get<string>(colorTokenName); }
-    public getCustomThemeSpecificColorToken(themeName: string, colorTokenName: string): string | undefined { return vscode.workspace.getConfiguration(`editor.tokenColorCustomizations.[${themeName}]`, this.resource).get<string>(colorTokenName); }
+    public getCustomColorToken(colorTokenName: string): string | undefined { return getCachedConfiguration("editor.tokenColorCustomizations").get<string>(colorTokenName); }
+    public getCustomThemeSpecificColorToken(themeName: string, colorTokenName: string): string | undefined { return getCachedConfiguration(`editor.tokenColorCustomizations.[${themeName}]`, this.resource).get<string>(colorTokenName); }
 
-    public get customTextMateRules(): TextMateRule[] | undefined { return vscode.workspace.getConfiguration("editor.tokenColorCustomizations").get<TextMateRule[]>("textMateRules"); }
-    public getCustomThemeSpecificTextMateRules(themeName: string): TextMateRule[] | undefined { return vscode.workspace.getConfiguration(`editor.tokenColorCustomizations.[${themeName}]`, this.resource).get<TextMateRule[]>("textMateRules"); }
+    public get customTextMateRules(): TextMateRule[] | undefined { return getCachedConfiguration("editor.tokenColorCustomizations").get<TextMateRule[]>("textMateRules"); }
+    public getCustomThemeSpecificTextMateRules(themeName: string): TextMateRule[] | undefined { return getCachedConfiguration(`editor.tokenColorCustomizations.[${themeName}]`, this.resource).get<TextMateRule[]>("textMateRules"); }
 }
 
 function mapIndentationReferenceToEditorConfig(value: string | undefined): string {
@@ -773,7 +795,7 @@ function mapWrapToEditorConfig(value: string | undefined): string {
 export function getEditorConfigSettings(fsPath: string): Promise<any> {
     let editorConfigSettings: any = cachedEditorConfigSettings.get(fsPath);
     if (!editorConfigSettings) {
-        editorConfigSettings = editorConfig.parseSync(fsPath);
+        editorConfigSettings = resolveEditorConfigSettings(fsPath);
         cachedEditorConfigSettings.set(fsPath, editorConfigSettings);
     }
     return editorConfigSettings;
@@ -0,0 +1,85 @@
+/* --------------------------------------------------------------------------------------------
+ * Copyright (c) Microsoft Corporation. All Rights Reserved.
+ * See 'LICENSE' in the project root for license information.
+ * ------------------------------------------------------------------------------------------ */
+'use strict';
+
+function isPlainObject(value: any): boolean {
+    return value !== null && typeof value === "object" && !(value instanceof Array);
+}
+
+function areEqual(a: any, b: any): boolean {
+    if (a === b) {
+        return true;
+    }
+    if (typeof a !== "object" || typeof b !== "object" || a === null || b === null || (a instanceof Array) !== (b instanceof Array)) {
+        return false;
+    }
+    const aKeys: string[] = Object.keys(a);
+    if (aKeys.length !== Object.keys(b).length) {
+        return false;
+    }
+    return aKeys.every(key => Object.prototype.hasOwnProperty.call(b, key) && areEqual(a[key], b[key]));
+}
+
+/**
+ * Returns the parts of `current` that differ from `previous`, or undefined if they are equal.
+ * Nested objects are compared per key, and only their changed keys are included. Keys that were
+ * removed are set to null. Arrays and other values are included whole when they differ.
+ */
+export function computeSettingsDelta(previous: any, current: any): any | undefined {
+    if (!isPlainObject(previous) || !isPlainObject(current)) {
+        return areEqual(previous, current) ? undefined : current;
+    }
+    const delta: { [key: string]: any } = {};
+    let changed: boolean = false;
+    for (const key of Object.keys(current)) {
+        const subDelta: any | undefined = Object.prototype.hasOwnProperty.call(previous, key) ? computeSettingsDelta(previous[key], current[key]) : current[key];
+        if (subDelta !== undefined) {
+            delta[key] = subDelta;
+            changed = true;
+        }
+    }
+    for (const key of Object.keys(previous)) {
+        if (!Object.prototype.hasOwnProperty.call(current, key)) {
+            delta[key] = null;
+            changed = true;
+        }
+    }
+    return changed ? delta : undefined;
+}
+
+export interface SettingsUpdate {
+    settings: any;
+    settingsVersion: number;
+    isDelta: boolean;
+}
+
+/**
+ * Tracks the settings last sent to the language server for one workspace folder, so that unchanged
+ * settings are not sent again.
+ */
+export class SettingsSyncState {
+    private lastSentSettings: any;
+    private version: number = 0;
+
+    /**
+     * Returns the update to send for the given settings, or undefined if they have not changed since
+     * the last update. The first update always contains all of the settings.
+     */
+    public getUpdate(settings: any, allowDelta: boolean): SettingsUpdate | undefined {
+        // Drop the functions of vscode.WorkspaceConfiguration objects; only the JSON data is sent.
+        const current: any = JSON.parse(JSON.stringify(settings));
+        if (this.lastSentSettings === undefined) {
+            this.lastSentSettings = current;
+            return { settings: current, settingsVersion: ++this.version, isDelta: false };
+        }
+        const delta: any | undefined = computeSettingsDelta(this.lastSentSettings, current);
+        if (delta === undefined) {
+            return undefined;
+        }
+        this.lastSentSettings = current;
+        return allowDelta ? { settings: delta, settingsVersion: ++this.version, isDelta: true }
+            : { settings: current, settingsVersion: ++this.version, isDelta: false };
+    }
+}
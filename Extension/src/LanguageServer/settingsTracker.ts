@@ -16,13 +16,23 @@ type KeyValuePair = { key: string; value: string };
 const maxSettingLengthForTelemetry: number = 50;
 let cache: SettingsTracker;
 
+/**
+ * Computes a structural fingerprint of a setting value, so that an unchanged setting subtree can be
+ * detected with a single string comparison instead of walking and inspecting every setting in it.
+ * V8's native JSON serializer is much faster than hashing the value in script, and the comparison is exact.
+ */
+export function getSettingFingerprint(value: any): string {
+    return JSON.stringify(value) ?? "undefined";
+}
+
 export class SettingsTracker {
     private previousCppSettings: { [key: string]: any } = {};
+    private previousSettingFingerprints: Map<string, string> = new Map<string, string>();
     private resource: vscode.Uri | undefined;
 
     constructor(resource: vscode.Uri | undefined) {
         this.resource = resource;
-        this.collectSettings(() => true);
+        this.collectSettings(() => true, true);
     }
 
     public getUserModifiedSettings(): { [key: string]: string } {
@@ -32,16 +42,28 @@ export class SettingsTracker {
 
     public getChangedSettings(): { [key: string]: string } {
         const filter: FilterFunction = (key: string, val: string) => !(key in this.previousCppSettings) || !this.areEqual(val, this.previousCppSettings[key]);
-        return this.collectSettings(filter);
+        return this.collectSettings(filter, true);
     }
 
-    private collectSettings(filter: FilterFunction): { [key: string]: string } {
+    /**
+     * @param skipUnchanged Skip settings (including all of their sub-settings) whose fingerprint is
+     * unchanged since the last call that used it.
+     */
+    private collectSettings(filter: FilterFunction, skipUnchanged: boolean = false): { [key: string]: string } {
         const settingsResourceScope: vscode.WorkspaceConfiguration = vscode.workspace.getConfiguration("C_Cpp", this.resource);
         const settingsNonScoped: vscode.WorkspaceConfiguration = vscode.workspace.getConfiguration("C_Cpp");
         const selectCorrectlyScopedSettings = (rawSetting: any): vscode.WorkspaceConfiguration =>
             (!rawSetting || rawSetting.scope === "resource" || rawSetting.scope === "machine-overridable") ? settingsResourceScope : settingsNonScoped;
         const result: { [key: string]: string } = {};
         for (const key in settingsResourceScope) {
+            if (skipUnchanged) {
+                // Sub-settings may come from either scope, so the fingerprint covers the values from both.
+                const fingerprint: string = getSettingFingerprint([settingsResourceScope.get(key), settingsNonScoped.get(key)]);
+                if (this.previousSettingFingerprints.get(key) === fingerprint) {
+                    continue;
+                }
+                this.previousSettingFingerprints.set(key, fingerprint);
+            }
             const rawSetting: any = util.packageJson.contributes.configuration.properties["C_Cpp." + key];
             const correctlyScopedSettings: vscode.WorkspaceConfiguration = selectCorrectlyScopedSettings(rawSetting);
             const val: any = this.getSetting(correctlyScopedSettings, key);
@@ -0,0 +1,93 @@
+/* --------------------------------------------------------------------------------------------
+ * Copyright (c) Microsoft Corporation. All Rights Reserved.
+ * See 'LICENSE' in the project root for license information.
+ * ------------------------------------------------------------------------------------------ */
+'use strict';
+
+import * as vscode from 'vscode';
+import * as util from '../common';
+
+export interface WorkspaceFolderEntry {
+    folder: vscode.WorkspaceFolder;
+    key: string; // util.asFolder(folder.uri)
+}
+
+interface TrieNode {
+    children: Map<string, TrieNode>;
+    entry?: WorkspaceFolderEntry;
+}
+
+// Bounds the memory used by the per-URI memo. The entries are cheap to recompute.
+const maxMemoizedUris: number = 10000;
+
+/**
+ * Maps URIs to their containing workspace folder, like vscode.workspace.getWorkspaceFolder, using a trie
+ * of path segments over the workspace folder roots. Results are memoized per URI, so routing repeated
+ * events for the same document is a single map lookup.
+ */
+export class WorkspaceFolderTrie {
+    private root: TrieNode = { children: new Map<string, TrieNode>() };
+    private memo: Map<string, WorkspaceFolderEntry | undefined> = new Map<string, WorkspaceFolderEntry | undefined>();
+
+    constructor(folders?: ReadonlyArray<vscode.WorkspaceFolder>) {
+        this.reset(folders);
+    }
+
+    public reset(folders?: ReadonlyArray<vscode.WorkspaceFolder>): void {
+        this.root = { children: new Map<string, TrieNode>() };
+        this.memo.clear();
+        if (folders) {
+            for (const folder of folders) {
+                let node: TrieNode = this.root;
+                for (const segment of WorkspaceFolderTrie.getSegments(folder.uri)) {
+                    let child: TrieNode | undefined = node.children.get(segment);
+                    if (!child) {
+                        child = { children: new Map<string, TrieNode>() };
+                        node.children.set(segment, child);
+                    }
+                    node = child;
+                }
+                node.entry = { folder: folder, key: util.asFolder(folder.uri) };
+            }
+        }
+    }
+
+    /**
+     * Returns the innermost workspace folder containing the URI, or undefined if there is none.
+     */
+    public getFolder(uri: vscode.Uri): WorkspaceFolderEntry | undefined {
+        const uriString: string = uri.toString();
+        if (this.memo.has(uriString)) {
+            return this.memo.get(uriString);
+        }
+        let result: WorkspaceFolderEntry | undefined = this.root.entry;
+        let node: TrieNode | undefined = this.root;
+        for (const segment of WorkspaceFolderTrie.getSegments(uri)) {
+            node = node.children.get(segment);
+            if (!node) {
+                break;
+            }
+            if (node.entry) {
+                result = node.entry;
+            }
+        }
+        if (this.memo.size >= maxMemoizedUris) {
+            this.memo.clear();
+        }
+        this.memo.set(uriString, result);
+        return result;
+    }
+
+    private static getSegments(uri: vscode.Uri): string[] {
+        // File paths are case insensitive on Windows and (by default) on macOS.
+        const ignoreCase: boolean = uri.scheme === "file" && (process.platform === "win32" || process.platform === "darwin");
+        const uriPath: string = ignoreCase ? uri.path.toLowerCase() : uri.path;
+        const segments: string[] = [uri.scheme + "://" + uri.authority.toLowerCase()];
+        for (const segment of uriPath.split("/")) {
+            if (segment.length > 0) {
+                segments.push(segment);
+            }
+        }
+        return segments;
+    }
+}
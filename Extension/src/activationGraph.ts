@@ -0,0 +1,62 @@
+/* --------------------------------------------------------------------------------------------
+ * Copyright (c) Microsoft Corporation. All Rights Reserved.
+ * See 'LICENSE' in the project root for license information.
+ * ------------------------------------------------------------------------------------------ */
+'use strict';
+
+import { activationTracer } from './activationTracer';
+
+interface ActivationStage {
+    dependencies: string[];
+    run: () => Thenable<void> | void;
+    completion?: Promise<void>;
+}
+
+/**
+ * Runs the stages of activation as a dependency graph. Each stage starts as soon as all of the stages
+ * it depends on have completed, so independent stages run concurrently. The timing of each stage is
+ * recorded by the activation tracer.
+ */
+export class ActivationGraph {
+    private stages: Map<string, ActivationStage> = new Map<string, ActivationStage>();
+
+    constructor(private category: string = "activation") {
+    }
+
+    public addStage(name: string, dependencies: string[], run: () => Thenable<void> | void): void {
+        if (this.stages.has(name)) {
+            throw new Error(`Duplicate activation stage: ${name}`);
+        }
+        this.stages.set(name, { dependencies: dependencies, run: run });
+    }
+
+    /**
+     * Starts all stages and resolves when they have completed. If a stage fails, the stages that depend
+     * on it are not run and the returned promise is rejected with the first failure.
+     */
+    public async run(): Promise<void> {
+        const completions: Promise<void>[] = [];
+        for (const name of this.stages.keys()) {
+            completions.push(this.start(name, new Set<string>()));
+        }
+        await Promise.all(completions);
+    }
+
+    private start(name: string, visiting: Set<string>): Promise<void> {
+        const stage: ActivationStage | undefined = this.stages.get(name);
+        if (!stage) {
+            return Promise.reject(new Error(`Unknown activation stage: ${name}`));
+        }
+        if (stage.completion) {
+            return stage.completion;
+        }
+        if (visiting.has(name)) {
+            return Promise.reject(new Error(`Activation stage dependency cycle: ${name}`));
+        }
+        visiting.add(name);
+        const dependencies: Promise<void>[] = stage.dependencies.map(dependency => this.start(dependency, visiting));
+        visiting.delete(name);
+        stage.completion = Promise.all(dependencies).then(() => activationTracer.traceAsync(name, async () => stage.run(), this.category));
+        return stage.completion;
+    }
+}
@@ -0,0 +1,152 @@
+/* --------------------------------------------------------------------------------------------
+ * Copyright (c) Microsoft Corporation. All Rights Reserved.
+ * See 'LICENSE' in the project root for license information.
+ * ------------------------------------------------------------------------------------------ */
+'use strict';
+
+import { performance } from 'perf_hooks';
+
+function padRight(text: string, width: number): string {
+    return text + " ".repeat(Math.max(0, width - text.length));
+}
+
+/**
+ * A timed stage of extension activation. Times are in milliseconds since the extension host started.
+ */
+export interface TraceSpan {
+    name: string;
+    category: string;
+    start: number;
+    end?: number; // Undefined while the span is still running, and for instant events (marks).
+    isMark?: boolean;
+}
+
+/**
+ * Records high-resolution spans for the stages of extension activation, so the critical path to the
+ * first IntelliSense result can be inspected as a Chrome trace (chrome://tracing, edge://tracing or
+ * https://ui.perfetto.dev) or as a text waterfall.
+ */
+export class ActivationTracer {
+    private spans: TraceSpan[] = [];
+    private marks: Set<string> = new Set<string>();
+
+    /**
+     * Starts a span and returns a function that ends it.
+     */
+    public startSpan(name: string, category: string = "activation"): () => void {
+        const span: TraceSpan = { name: name, category: category, start: performance.now() };
+        this.spans.push(span);
+        return () => {
+            if (span.end === undefined) {
+                span.end = performance.now();
+            }
+        };
+    }
+
+    public trace<T>(name: string, work: () => T, category?: string): T {
+        const endSpan: () => void = this.startSpan(name, category);
+        try {
+            return work();
+        } finally {
+            endSpan();
+        }
+    }
+
+    public async traceAsync<T>(name: string, work: () => Thenable<T>, category?: string): Promise<T> {
+        const endSpan: () => void = this.startSpan(name, category);
+        try {
+            return await work();
+        } finally {
+            endSpan();
+        }
+    }
+
+    /**
+     * Records an instant event. Only the first occurrence of each mark is recorded.
+     */
+    public mark(name: string, category: string = "activation"): void {
+        if (!this.marks.has(name)) {
+            this.marks.add(name);
+            this.spans.push({ name: name, category: category, start: performance.now(), isMark: true });
+        }
+    }
+
+    public get Spans(): ReadonlyArray<TraceSpan> {
+        return this.spans;
+    }
+
+    /**
+     * Returns the spans in the Chrome trace event format.
+     */
+    public toChromeTrace(): any {
+        const traceEvents: any[] = [];
+        const now: number = performance.now();
+        // Overlapping spans that do not nest are placed on separate tracks (thread ids) so they display correctly.
+        const tracks: TraceSpan[][] = [];
+        for (const span of this.sortedSpans()) {
+            if (span.isMark) {
+                traceEvents.push({ name: span.name, cat: span.category, ph: "i", s: "g", ts: span.start * 1000, pid: process.pid, tid: 0 });
+                continue;
+            }
+            const end: number = span.end ?? now;
+            let track: number = 0;
+            for (; track < tracks.length; ++track) {
+                const open: TraceSpan[] = tracks[track];
+                while (open.length > 0 && (open[open.length - 1].end ?? now) <= span.start) {
+                    open.pop();
+                }
+                if (open.length === 0 || (open[open.length - 1].end ?? now) >= end) {
+                    break;
+                }
+            }
+            if (track === tracks.length) {
+                tracks.push([]);
+            }
+            tracks[track].push(span);
+            traceEvents.push({
+                name: span.name,
+                cat: span.category,
+                ph: "X",
+                ts: span.start * 1000,
+                dur: (end - span.start) * 1000,
+                pid: process.pid,
+                tid: track + 1,
+                args: span.end === undefined ? { unfinished: true } : undefined
+            });
+        }
+        return { traceEvents: traceEvents, displayTimeUnit: "ms" };
+    }
+
+    /**
+     * Returns the spans as a text waterfall, with times relative to the start of the first span.
+     */
+    public toWaterfall(): string {
+        const spans: TraceSpan[] = this.sortedSpans();
+        if (spans.length === 0) {
+            return "";
+        }
+        const now: number = performance.now();
+        const origin: number = spans[0].start;
+        const total: number = Math.max(...spans.map(s => (s.end ?? (s.isMark ? s.start : now)) - origin), 1);
+        const barWidth: number = 40;
+        const nameWidth: number = Math.max(...spans.map(s => s.name.length));
+        const lines: string[] = [];
+        for (const span of spans) {
+            const offset: number = span.start - origin;
+            const duration: number = span.isMark ? 0 : (span.end ?? now) - span.start;
+            const barStart: number = Math.floor(offset / total * barWidth);
+            const barLength: number = span.isMark ? 1 : Math.max(1, Math.round(duration / total * barWidth));
+            const bar: string = " ".repeat(barStart) + (span.isMark ? "|" : "#".repeat(Math.min(barLength, barWidth - barStart)));
+            const timing: string = span.isMark ? `@ ${offset.toFixed(1)} ms` : `${offset.toFixed(1)} ms + ${duration.toFixed(1)} ms${span.end === undefined ? " (unfinished)" : ""}`;
+            lines.push(`${padRight(span.name, nameWidth)}  ${padRight(bar, barWidth)}  ${timing}`);
+        }
+        return lines.join("\n");
+    }
+
+    private sortedSpans(): TraceSpan[] {
+        // Sort by start time. Enclosing spans go before the spans they contain.
+        return [...this.spans].sort((a, b) => a.start - b.start || (b.end ?? Infinity) - (a.end ?? Infinity));
+    }
+}
+
+export const activationTracer: ActivationTracer = new ActivationTracer();
@@ -14,6 +14,24 @@ export function subscribeToAllLoggers(subscriber: (message: string) => void): vo
     Subscriber = subscriber;
 }
 
+export enum LogLevel {
+    None,
+    Error,
+    Warning,
+    Information,
+    Debug
+}
+
+export function getLogLevel(): LogLevel {
+    switch (new CppSettings().loggingLevel) {
+        case "Error": return LogLevel.Error;
+        case "Warning": return LogLevel.Warning;
+        case "Information": return LogLevel.Information;
+        case "Debug": return LogLevel.Debug;
+        default: return LogLevel.None;
+    }
+}
+
 export class Logger {
     private writer: (message: string) => void;
 
@@ -21,6 +39,16 @@ export class Logger {
         this.writer = writer;
     }
 
+    /**
+     * Appends a line only if the active logging level is at least `level`.
+     * The message is not formatted unless it will be written, so it can be expensive to construct.
+     */
+    public appendLineAtLevel(level: LogLevel, formatMessage: () => string): void {
+        if (getLogLevel() >= level) {
+            this.appendLine(formatMessage());
+        }
+    }
+
     public append(message: string): void {
         this.writer(message);
         if (Subscriber) {
@@ -68,7 +96,7 @@ export class Logger {
 
 let outputChannel: vscode.OutputChannel | undefined;
 
-export function getOutputChannel(): vscode.OutputChannel {
+function getRawOutputChannel(): vscode.OutputChannel {
     if (!outputChannel) {
         outputChannel = vscode.window.createOutputChannel("C/C++");
         const settings: CppSettings = new CppSettings();
@@ -80,6 +108,63 @@ export function getOutputChannel(): vscode.OutputChannel {
     return outputChannel;
 }
 
+// Output channel writes are batched and flushed on a timer, so that heavy logging does not add
+// a round trip to the output channel for every line.
+const outputFlushDelayMs: number = 100;
+let pendingOutput: string[] = [];
+let outputFlushTimer: NodeJS.Timer | undefined;
+
+export function flushOutputChannel(): void {
+    if (outputFlushTimer) {
+        global.clearTimeout(outputFlushTimer);
+        outputFlushTimer = undefined;
+    }
+    if (pendingOutput.length > 0) {
+        const output: string = pendingOutput.join("");
+        pendingOutput = [];
+        getRawOutputChannel().append(output);
+    }
+}
+
+function appendToOutputChannel(message: string): void {
+    pendingOutput.push(message);
+    if (!outputFlushTimer) {
+        outputFlushTimer = global.setTimeout(flushOutputChannel, outputFlushDelayMs);
+    }
+}
+
+// The "C/C++" output channel. Its writes go through the same batch as the output channel logger's,
+// so that they appear in the order they were made.
+const batchedOutputChannel: vscode.OutputChannel = {
+    name: "C/C++",
+    append: (value: string) => appendToOutputChannel(value),
+    appendLine: (value: string) => appendToOutputChannel(value + os.EOL),
+    clear: () => {
+        pendingOutput = [];
+        getRawOutputChannel().clear();
+    },
+    show: (columnOrPreserveFocus?: vscode.ViewColumn | boolean, preserveFocus?: boolean) => {
+        flushOutputChannel();
+        if (typeof columnOrPreserveFocus === "boolean") {
+            getRawOutputChannel().show(columnOrPreserveFocus);
+        } else {
+            getRawOutputChannel().show(columnOrPreserveFocus, preserveFocus);
+        }
+    },
+    hide: () => getRawOutputChannel().hide(),
+    dispose: () => {
+        flushOutputChannel();
+        if (outputChannel) {
+            outputChannel.dispose();
+            outputChannel = undefined;
+        }
+    }
+};
+
+export function getOutputChannel(): vscode.OutputChannel {
+    return batchedOutputChannel;
+}
+
 export function showOutputChannel(): void {
     getOutputChannel().show();
 }
@@ -88,7 +173,7 @@ let outputChannelLogger: Logger | undefined;
 
 export function getOutputChannelLogger(): Logger {
     if (!outputChannelLogger) {
-        outputChannelLogger = new Logger(message => getOutputChannel().append(message));
+        outputChannelLogger = new Logger(appendToOutputChannel);
     }
     return outputChannelLogger;
 }
@@ -20,10 +20,12 @@ import { getTemporaryCommandRegistrarInstance, initializeTemporaryCommandRegistr
 import { PlatformInformation, GetOSName } from './platform';
 import { PackageManager, PackageManagerError, IPackage, VersionsMatch, ArchitecturesMatch, PlatformsMatch } from './packageManager';
 import { getInstallationInformation, InstallationInformation, setInstallationStage, setInstallationType, InstallationType } from './installationInformation';
-import { Logger, getOutputChannelLogger, showOutputChannel } from './logger';
+import { Logger, getOutputChannelLogger, showOutputChannel, flushOutputChannel } from './logger';
 import { CppTools1, NullCppTools } from './cppTools1';
-import { CppSettings } from './LanguageServer/settings';
+import { CppSettings, configurationCacheListener } from './LanguageServer/settings';
 import { vsixNameForPlatform, releaseDownloadUrl } from './githubAPI';
+import { activationTracer } from './activationTracer';
+import { ActivationGraph } from './activationGraph';
 
 nls.config({ messageFormat: nls.MessageFormat.bundle, bundleFormat: nls.BundleFormat.standalone })();
 const localize: nls.LocalizeFunc = nls.loadMessageBundle();
@@ -34,15 +36,25 @@ let reloadMessageShown: boolean = false;
 const disposables: vscode.Disposable[] = [];
 
 export async function activate(context: vscode.ExtensionContext): Promise<CppToolsApi & CppToolsExtension> {
-    await util.checkCuda();
+    const endActivateSpan: () => void = activationTracer.startSpan("activate");
+    try {
+        return await activateInternal(context);
+    } finally {
+        endActivateSpan();
+    }
+}
 
+async function activateInternal(context: vscode.ExtensionContext): Promise<CppToolsApi & CppToolsExtension> {
+    disposables.push(configurationCacheListener);
     let errMsg: string = "";
     const arch: string = PlatformInformation.GetArchitecture();
+    const endPlatformCheckSpan: () => void = activationTracer.startSpan("checkPlatformSupport");
     if (arch !== 'x64' && (process.platform !== 'win32' || (arch !== 'x86' && arch !== 'arm64')) && ((process.platform === 'win32' || process.platform === 'darwin') || (arch !== 'arm' && arch !== 'arm64')) && (process.platform !== 'darwin' || arch !== 'arm64')) {
         errMsg = localize("architecture.not.supported", "Architecture {0} is not supported. ", String(arch));
     } else if (process.platform === 'linux' && await util.checkDirectoryExists('/etc/alpine-release')) {
         errMsg = localize("apline.containers.not.supported", "Alpine containers are not supported.");
     }
+    endPlatformCheckSpan();
     if (errMsg) {
         vscode.window.showErrorMessage(errMsg);
         return new NullCppTools();
@@ -50,9 +62,11 @@ export async function activate(context: vscode.ExtensionContext): Promise<CppToo
 
     util.setExtensionContext(context);
     initializeTemporaryCommandRegistrar();
-    Telemetry.activate();
+    activationTracer.trace("Telemetry.activate", () => Telemetry.activate());
     util.setProgress(0);
 
+    disposables.push(vscode.commands.registerCommand("C_Cpp.LogActivationTrace", onLogActivationTrace));
+
     // Register a protocol handler to serve localized versions of the schema for c_cpp_properties.json
     class SchemaProvider implements vscode.TextDocumentContentProvider {
         public async provideTextDocumentContent(uri: vscode.Uri): Promise<string> {
@@ -70,11 +84,28 @@ export async function activate(context: vscode.ExtensionContext): Promise<CppToo
 
     vscode.workspace.registerTextDocumentContentProvider('cpptools-schema', new SchemaProvider());
 
+    // The remaining stages run concurrently where they are independent, so that the language server
+    // (started at the end of processRuntimeDependencies) is not delayed by unrelated work.
+    let installLockExists: boolean = false;
+    let info: PlatformInformation | undefined;
+    const graph: ActivationGraph = new ActivationGraph();
+    graph.addStage("checkCuda", [], () => util.checkCuda());
+    graph.addStage("checkInstallLockFile", [], async () => { installLockExists = await util.checkInstallLockFile(); });
+    graph.addStage("getPlatformInformation", [], async () => { info = await PlatformInformation.GetPlatformInformation(); });
     // Initialize the DebuggerExtension and register the related commands and providers.
-    DebuggerExtension.initialize(context);
+    graph.addStage("DebuggerExtension.initialize", [], () => DebuggerExtension.initialize(context));
+    graph.addStage("processRuntimeDependencies", ["checkCuda", "checkInstallLockFile", "getPlatformInformation"],
+        () => processRuntimeDependencies(installLockExists, <PlatformInformation>info));
+    // processRuntimeDependencies can install, clean up or rewrite the binaries, so they are checked afterwards.
+    graph.addStage("checkInstallation", ["processRuntimeDependencies"], () => checkInstallation(arch, <PlatformInformation>info));
+    setInstallationStage('getPlatformInfo');
+    await graph.run();
 
-    await processRuntimeDependencies();
+    return cppTools;
+}
 
+async function checkInstallation(arch: string, info: PlatformInformation): Promise<void> {
+    let errMsg: string = "";
     // Read archictures of binaries from install.lock
     const fileContents: string = await util.readFileText(util.getInstallLockPath());
     // Assume current platform if install.lock is empty.
@@ -101,8 +132,7 @@ export async function activate(context: vscode.ExtensionContext): Promise<CppToo
             // On arm64 macOS, allow x64 binaries.
             && !(process.platform === "darwin" && arch === "arm64" && installedPlatformAndArchitecture.architecture === "x64"))) {
         // Check if the correct offline/insiders vsix is installed on the correct platform.
-        const platformInfo: PlatformInformation = await PlatformInformation.GetPlatformInformation();
-        const vsixName: string = vsixNameForPlatform(platformInfo);
+        const vsixName: string = vsixNameForPlatform(info);
         const downloadLink: string = localize("download.button", "Go to Download Page");
         errMsg = localize("native.binaries.not.supported", "This {0} {1} version of the extension is incompatible with your OS. Please download and install the \"{2}\" version of the extension.", GetOSName(installedPlatformAndArchitecture.platform), installedPlatformAndArchitecture.architecture, vsixName);
         vscode.window.showErrorMessage(errMsg, downloadLink).then(async (selection) => {
@@ -129,11 +159,23 @@ export async function activate(context: vscode.ExtensionContext): Promise<CppToo
             }
         });
     }
+}
 
-    return cppTools;
+async function onLogActivationTrace(): Promise<void> {
+    const outputChannelLogger: Logger = getOutputChannelLogger();
+    outputChannelLogger.appendLine(localize("activation.trace", "Activation trace:"));
+    outputChannelLogger.appendLine(activationTracer.toWaterfall());
+    showOutputChannel();
+    // The trace can be saved and loaded into chrome://tracing, edge://tracing or https://ui.perfetto.dev.
+    const document: vscode.TextDocument = await vscode.workspace.openTextDocument({
+        language: "json",
+        content: JSON.stringify(activationTracer.toChromeTrace(), null, 2)
+    });
+    await vscode.window.showTextDocument(document);
 }
 
 export function deactivate(): Thenable<void> {
+    flushOutputChannel();
     DebuggerExtension.dispose();
     Telemetry.deactivate();
     disposables.forEach(d => d.dispose());
@@ -144,12 +186,7 @@ export function deactivate(): Thenable<void> {
     return LanguageServer.deactivate();
 }
 
-async function processRuntimeDependencies(): Promise<void> {
-    const installLockExists: boolean = await util.checkInstallLockFile();
-
-    setInstallationStage('getPlatformInfo');
-    const info: PlatformInformation = await PlatformInformation.GetPlatformInformation();
-
+async function processRuntimeDependencies(installLockExists: boolean, info: PlatformInformation): Promise<void> {
     let forceOnlineInstall: boolean = false;
     if (info.platform === "darwin" && info.version) {
         const darwinVersion: PersistentState<string | undefined> = new PersistentState("Cpp.darwinVersion", info.version);
@@ -444,6 +481,7 @@ function rewriteManifest(): Promise<void> {
         "onCommand:C_Cpp.GoToNextDirectiveInGroup",
         "onCommand:C_Cpp.GoToPrevDirectiveInGroup",
         "onCommand:C_Cpp.CheckForCompiler",
+        "onCommand:C_Cpp.LogActivationTrace",
         "onDebugInitialConfigurations",
         "onDebugResolve:cppdbg",
         "onDebugResolve:cppvsdbg",
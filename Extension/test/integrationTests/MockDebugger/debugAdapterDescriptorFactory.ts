@@ -17,7 +17,7 @@ abstract class AbstractDebugAdapterDescriptorFactory implements vscode.DebugAdap
     abstract createDebugAdapterDescriptor(session: vscode.DebugSession, executable?: vscode.DebugAdapterExecutable): vscode.ProviderResult<vscode.DebugAdapterDescriptor>;
 }
 
-export class CppdbgDebugAdapterDescriptorFactory extends AbstractDebugAdapterDescriptorFactory {
+export class CppdbgDebugAdapterDescriptorFactory extends AbstractDebugAdapterDescriptorFactory implements vscode.Disposable {
     public static DEBUG_TYPE: string = "cppdbg";
 
     constructor(context: vscode.ExtensionContext) {
@@ -29,6 +29,9 @@ export class CppdbgDebugAdapterDescriptorFactory extends AbstractDebugAdapterDes
 
         return new vscode.DebugAdapterExecutable('node', [path.join(this.context.extensionPath, './out/test/integrationTests/MockDebugger/mockDebug.js')]);
     }
+
+    dispose(): void {
+    }
 }
 
 export class CppvsdbgDebugAdapterDescriptorFactory extends AbstractDebugAdapterDescriptorFactory {
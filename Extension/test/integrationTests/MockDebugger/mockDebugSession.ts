@@ -3,7 +3,7 @@
  * See 'LICENSE' in the project root for license information.
  * ------------------------------------------------------------------------------------------ */
 
-import { Logger, logger, LoggingDebugSession, InitializedEvent, TerminatedEvent } from 'vscode-debugadapter';
+import { Logger, logger, LoggingDebugSession, InitializedEvent, TerminatedEvent, StoppedEvent, Thread, StackFrame, Scope, Source } from 'vscode-debugadapter';
 import { DebugProtocol } from 'vscode-debugprotocol';
 import { Subject } from 'await-notify';
 
@@ -13,10 +13,24 @@ interface LaunchRequestArguments extends DebugProtocol.LaunchRequestArguments {
 
     /** enable logging the Debug Adapter Protocol */
     logPath?: string;
+
+    /** Stop after launch instead of terminating, so that stack, variable and step requests can be made. */
+    stopAtEntry?: boolean;
+
+    /** The number of variables in the "Locals" scope. Each of them has mockChildCount children. */
+    mockVariableCount?: number;
+    mockChildCount?: number;
 }
 
+const threadId: number = 1;
+const localsReference: number = 1;
+
 export class MockDebugSession extends LoggingDebugSession {
     private _configurationDone = new Subject();
+    private _variableCount: number = 100;
+    private _childCount: number = 10;
+    private _line: number = 1;
+    private _program: string = "";
 
     public constructor() {
         super("mock-debug.txt");
@@ -55,7 +69,57 @@ export class MockDebugSession extends LoggingDebugSession {
 
         this.sendResponse(response);
 
-        // Terminate after launch.
+        if (args.stopAtEntry) {
+            this._program = args.program;
+            this._variableCount = args.mockVariableCount ?? this._variableCount;
+            this._childCount = args.mockChildCount ?? this._childCount;
+            this.sendEvent(new StoppedEvent("entry", threadId));
+        } else {
+            // Terminate after launch.
+            this.sendEvent(new TerminatedEvent());
+        }
+    }
+
+    protected threadsRequest(response: DebugProtocol.ThreadsResponse): void {
+        response.body = { threads: [new Thread(threadId, "main")] };
+        this.sendResponse(response);
+    }
+
+    protected stackTraceRequest(response: DebugProtocol.StackTraceResponse, args: DebugProtocol.StackTraceArguments): void {
+        response.body = { stackFrames: [new StackFrame(1, "main", new Source("main.cpp", this._program), this._line)], totalFrames: 1 };
+        this.sendResponse(response);
+    }
+
+    protected scopesRequest(response: DebugProtocol.ScopesResponse, args: DebugProtocol.ScopesArguments): void {
+        response.body = { scopes: [new Scope("Locals", localsReference, false)] };
+        this.sendResponse(response);
+    }
+
+    // The locals are structs (variablesReference localsReference + 1 + index) whose children are ints.
+    protected variablesRequest(response: DebugProtocol.VariablesResponse, args: DebugProtocol.VariablesArguments): void {
+        const variables: DebugProtocol.Variable[] = [];
+        if (args.variablesReference === localsReference) {
+            for (let i: number = 0; i < this._variableCount; ++i) {
+                variables.push({ name: `local${i}`, value: "{...}", type: "struct mock", variablesReference: localsReference + 1 + i });
+            }
+        } else {
+            const parent: number = args.variablesReference - localsReference - 1;
+            for (let i: number = 0; i < this._childCount; ++i) {
+                variables.push({ name: `field${i}`, value: `${parent * this._childCount + i}`, type: "int", variablesReference: 0 });
+            }
+        }
+        response.body = { variables: variables };
+        this.sendResponse(response);
+    }
+
+    protected nextRequest(response: DebugProtocol.NextResponse, args: DebugProtocol.NextArguments): void {
+        this._line++;
+        this.sendResponse(response);
+        this.sendEvent(new StoppedEvent("step", threadId));
+    }
+
+    protected continueRequest(response: DebugProtocol.ContinueResponse, args: DebugProtocol.ContinueArguments): void {
+        this.sendResponse(response);
         this.sendEvent(new TerminatedEvent());
     }
 
@@ -0,0 +1,152 @@
+/* --------------------------------------------------------------------------------------------
+ * Copyright (c) Microsoft Corporation. All Rights Reserved.
+ * See 'LICENSE' in the project root for license information.
+ * ------------------------------------------------------------------------------------------ */
+import * as vscode from 'vscode';
+import * as assert from 'assert';
+import * as fs from 'fs';
+import * as os from 'os';
+import * as path from 'path';
+import { performance } from 'perf_hooks';
+
+// Measures the debug launch path (configuration resolution and createDebugAdapterDescriptor) and the
+// request round trips of a session, against the mock debug adapter (see MockDebugger) used by the debug integration tests.
+// The results are written to CPPTOOLS_DEBUG_BENCHMARK_REPORT (default: <tmpdir>/cpptools-debug-benchmark.json). If
+// CPPTOOLS_DEBUG_BENCHMARK_BASELINE names a report from an earlier run, the change from it is printed for each metric.
+
+interface BenchmarkResult {
+    name: string;
+    value: number;
+    unit: string;
+    higherIsBetter?: boolean;
+}
+
+const sessionCount: number = 5;
+const stepCount: number = 20;
+const variableCount: number = 200;
+const childCount: number = 10;
+
+function median(values: number[]): number {
+    const sorted: number[] = [...values].sort((a, b) => a - b);
+    return sorted[Math.floor(sorted.length / 2)];
+}
+
+function formatReport(results: BenchmarkResult[], baseline?: BenchmarkResult[]): string {
+    const lines: string[] = [];
+    for (const result of results) {
+        let line: string = `    ${result.name}: ${result.value.toFixed(2)} ${result.unit}`;
+        const previous: BenchmarkResult | undefined = baseline?.find(b => b.name === result.name);
+        if (previous && previous.value > 0) {
+            const change: number = (result.value - previous.value) / previous.value * 100;
+            const isRegression: boolean = result.higherIsBetter ? change < 0 : change > 0;
+            line += ` (baseline ${previous.value.toFixed(2)}, ${change >= 0 ? "+" : ""}${change.toFixed(1)}%${isRegression && Math.abs(change) >= 10 ? ", REGRESSION" : ""})`;
+        }
+        lines.push(line);
+    }
+    return lines.join("\n");
+}
+
+suite(`Debug Adapter Benchmark: `, function(): void {
+    let onStopped: (() => void) | undefined;
+    let trackerFactory: vscode.Disposable;
+
+    suiteSetup(async function(): Promise<void> {
+        const extension: vscode.Extension<any> = vscode.extensions.getExtension("ms-vscode.cpptools");
+        if (!extension.isActive) {
+            await extension.activate();
+        }
+        trackerFactory = vscode.debug.registerDebugAdapterTrackerFactory("cppdbg", {
+            createDebugAdapterTracker: () => ({
+                onDidSendMessage: (message: any) => {
+                    if (message.type === "event" && message.event === "stopped" && onStopped) {
+                        const stopped: () => void = onStopped;
+                        onStopped = undefined;
+                        stopped();
+                    }
+                }
+            })
+        });
+    });
+
+    suiteTeardown(() => {
+        trackerFactory.dispose();
+    });
+
+    function waitForStop(): Promise<void> {
+        return new Promise<void>(resolve => { onStopped = resolve; });
+    }
+
+    test("Launch, variable expansion and step latency", async () => {
+        const folder: vscode.WorkspaceFolder = vscode.workspace.workspaceFolders[0];
+        const config: vscode.DebugConfiguration = {
+            name: "(gdb) Benchmark",
+            type: "cppdbg",
+            request: "launch",
+            program: "${workspaceFolder}/program",
+            cwd: "${workspaceFolder}",
+            stopAtEntry: true,
+            environment: [],
+            mockVariableCount: variableCount,
+            mockChildCount: childCount
+        };
+
+        const launchTimes: number[] = [];
+        const firstStopTimes: number[] = [];
+        const variableRates: number[] = [];
+        const stepTimes: number[] = [];
+        for (let i: number = 0; i < sessionCount; ++i) {
+            // Time to the session starting covers configuration resolution and createDebugAdapterDescriptor.
+            const start: number = performance.now();
+            const sessionStarted: Promise<vscode.DebugSession> = new Promise(resolve => {
+                const listener: vscode.Disposable = vscode.debug.onDidStartDebugSession(session => { listener.dispose(); resolve(session); });
+            });
+            const stopped: Promise<void> = waitForStop();
+            assert.ok(await vscode.debug.startDebugging(folder, config), "Debugger failed to launch. Did the extension activate correctly?");
+            const session: vscode.DebugSession = await sessionStarted;
+            launchTimes.push(performance.now() - start);
+            await stopped;
+            firstStopTimes.push(performance.now() - start);
+
+            // Expand the locals and each of their children.
+            const expandStart: number = performance.now();
+            const locals: any = await session.customRequest("variables", { variablesReference: 1 });
+            let expanded: number = locals.variables.length;
+            for (const variable of locals.variables) {
+                const children: any = await session.customRequest("variables", { variablesReference: variable.variablesReference });
+                expanded += children.variables.length;
+            }
+            variableRates.push(expanded / ((performance.now() - expandStart) / 1000));
+            assert.strictEqual(expanded, variableCount * (childCount + 1));
+
+            for (let step: number = 0; step < stepCount; ++step) {
+                const stepStart: number = performance.now();
+                const stepped: Promise<void> = waitForStop();
+                await session.customRequest("next", { threadId: 1 });
+                await stepped;
+                stepTimes.push(performance.now() - stepStart);
+            }
+
+            const terminated: Promise<void> = new Promise(resolve => {
+                const listener: vscode.Disposable = vscode.debug.onDidTerminateDebugSession(() => { listener.dispose(); resolve(); });
+            });
+            await session.customRequest("continue", { threadId: 1 });
+            await terminated;
+        }
+
+        const results: BenchmarkResult[] = [
+            { name: "resolveAndCreateAdapter", value: median(launchTimes), unit: "ms" },
+            { name: "timeToFirstStop", value: median(firstStopTimes), unit: "ms" },
+            { name: "variableExpansion", value: median(variableRates), unit: "variables/s", higherIsBetter: true },
+            { name: "stepLatency", value: median(stepTimes), unit: "ms" }
+        ];
+
+        let baseline: BenchmarkResult[] | undefined;
+        const baselinePath: string | undefined = process.env.CPPTOOLS_DEBUG_BENCHMARK_BASELINE;
+        if (baselinePath && fs.existsSync(baselinePath)) {
+            baseline = JSON.parse(fs.readFileSync(baselinePath, "utf8"));
+        }
+        const reportPath: string = process.env.CPPTOOLS_DEBUG_BENCHMARK_REPORT || path.join(os.tmpdir(), "cpptools-debug-benchmark.json");
+        fs.writeFileSync(reportPath, JSON.stringify(results, undefined, 2));
+        console.log(`    Debug adapter benchmark (median of ${sessionCount} sessions), written to ${reportPath}:\n${formatReport(results, baseline)}`);
+    });
+});
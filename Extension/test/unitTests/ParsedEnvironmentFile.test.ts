@@ -4,6 +4,9 @@
  * ------------------------------------------------------------------------------------------ */
 import { Environment, ParsedEnvironmentFile } from '../../src/Debugger/ParsedEnvironmentFile';
 import * as assert from 'assert';
+import * as fs from 'fs';
+import * as os from 'os';
+import * as path from 'path';
 
 // Because the environment variable is set as an array, the index does not matter.
 function assertEnvironmentEqual(env: Environment[], name: string, value: string): void {
@@ -106,4 +109,55 @@ MyName2=Value2
         assertEnvironmentEqual(result.Env, "MyName1", "Value1");
         assertEnvironmentEqual(result.Env, "MyName2", "Value2");
     });
+
+    test("Read file asynchronously and cache until it changes", async () => {
+        const envFile: string = path.join(fs.mkdtempSync(path.join(os.tmpdir(), "envFile")), "test.env");
+        const lines: string[] = [];
+        for (let i: number = 0; i < 10000; ++i) {
+            lines.push(`MyName${i}="Value${i}"`);
+        }
+        fs.writeFileSync(envFile, "\uFEFF" + lines.join("\r\n") + "\r\nThis_Line_Is_Wrong\r\n");
+
+        const initialEnv: Environment[] = [{ name: "MyName1", value: "Value7" }, { name: "ThisShouldNotChange", value: "StillHere" }];
+        const result: ParsedEnvironmentFile = await ParsedEnvironmentFile.CreateFromFileAsync(envFile, initialEnv);
+        assert.deepStrictEqual(result, ParsedEnvironmentFile.CreateFromFile(envFile, initialEnv));
+        assert.strictEqual(result.Env.length, 10001);
+        assertEnvironmentEqual(result.Env, "MyName1", "Value1");
+        assertEnvironmentEqual(result.Env, "MyName9999", "Value9999");
+        assertEnvironmentEqual(result.Env, "ThisShouldNotChange", "StillHere");
+        assert(result.Warning && result.Warning.endsWith(`"This_Line_Is_Wrong\r".`), 'Checking if warning exists');
+
+        // Cached results are not shared between callers.
+        result.Env[0].value = "Changed";
+        const cached: ParsedEnvironmentFile = await ParsedEnvironmentFile.CreateFromFileAsync(envFile, initialEnv);
+        assertEnvironmentEqual(cached.Env, "MyName1", "Value1");
+
+        fs.writeFileSync(envFile, "MyName1=Updated\n");
+        const updated: ParsedEnvironmentFile = await ParsedEnvironmentFile.CreateFromFileAsync(envFile);
+        assert.strictEqual(updated.Env.length, 1);
+        assertEnvironmentEqual(updated.Env, "MyName1", "Updated");
+    });
+
+    test("Cached files are read again when their modification time or size changes", async () => {
+        const envFile: string = path.join(fs.mkdtempSync(path.join(os.tmpdir(), "envFile")), "test.env");
+        const time: Date = new Date(2020, 0, 1);
+        const writeFile = (content: string, modified: Date): void => {
+            fs.writeFileSync(envFile, content);
+            fs.utimesSync(envFile, modified, modified);
+        };
+        writeFile("MyName=One\n", time);
+        assertEnvironmentEqual((await ParsedEnvironmentFile.CreateFromFileAsync(envFile)).Env, "MyName", "One");
+
+        // Same modification time and size: the cached result is used.
+        writeFile("MyName=Two\n", time);
+        assertEnvironmentEqual((await ParsedEnvironmentFile.CreateFromFileAsync(envFile)).Env, "MyName", "One");
+
+        // Only the modification time changed.
+        writeFile("MyName=Two\n", new Date(2020, 0, 2));
+        assertEnvironmentEqual((await ParsedEnvironmentFile.CreateFromFileAsync(envFile)).Env, "MyName", "Two");
+
+        // Only the size changed.
+        writeFile("MyName=Three\n", new Date(2020, 0, 2));
+        assertEnvironmentEqual((await ParsedEnvironmentFile.CreateFromFileAsync(envFile)).Env, "MyName", "Three");
+    });
 });
@@ -0,0 +1,38 @@
+/* --------------------------------------------------------------------------------------------
+ * Copyright (c) Microsoft Corporation. All Rights Reserved.
+ * See 'LICENSE' in the project root for license information.
+ * ------------------------------------------------------------------------------------------ */
+import * as assert from "assert";
+import { ActivationGraph } from "../../src/activationGraph";
+
+function delay(ms: number): Promise<void> {
+    return new Promise<void>(resolve => setTimeout(resolve, ms));
+}
+
+suite("Activation graph", () => {
+    test("Independent stages run concurrently and dependents wait", async () => {
+        const events: string[] = [];
+        const graph: ActivationGraph = new ActivationGraph("test");
+        graph.addStage("c", ["a", "b"], () => { events.push("c"); });
+        graph.addStage("a", [], async () => { events.push("a start"); await delay(20); events.push("a end"); });
+        graph.addStage("b", [], async () => { events.push("b start"); await delay(5); events.push("b end"); });
+        await graph.run();
+        assert.deepStrictEqual(events, ["a start", "b start", "b end", "a end", "c"]);
+    });
+
+    test("Dependents of a failed stage are not run", async () => {
+        let dependentRan: boolean = false;
+        const graph: ActivationGraph = new ActivationGraph("test");
+        graph.addStage("a", [], () => { throw new Error("failed"); });
+        graph.addStage("b", ["a"], () => { dependentRan = true; });
+        await assert.rejects(graph.run(), /failed/);
+        assert.strictEqual(dependentRan, false);
+    });
+
+    test("Dependency cycles are rejected", async () => {
+        const graph: ActivationGraph = new ActivationGraph("test");
+        graph.addStage("a", ["b"], () => undefined);
+        graph.addStage("b", ["a"], () => undefined);
+        await assert.rejects(graph.run(), /cycle/);
+    });
+});
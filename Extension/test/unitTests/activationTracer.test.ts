@@ -0,0 +1,36 @@
+/* --------------------------------------------------------------------------------------------
+ * Copyright (c) Microsoft Corporation. All Rights Reserved.
+ * See 'LICENSE' in the project root for license information.
+ * ------------------------------------------------------------------------------------------ */
+import * as assert from "assert";
+import { ActivationTracer } from "../../src/activationTracer";
+
+suite("Activation tracer", () => {
+    test("Overlapping spans that do not nest are placed on separate tracks", async () => {
+        const tracer: ActivationTracer = new ActivationTracer();
+        const endOuter: () => void = tracer.startSpan("outer");
+        tracer.trace("nested", () => undefined);
+        const endFirst: () => void = tracer.startSpan("first");
+        await new Promise<void>(resolve => setTimeout(resolve, 5));
+        const endSecond: () => void = tracer.startSpan("second");
+        await new Promise<void>(resolve => setTimeout(resolve, 5));
+        endFirst();
+        await new Promise<void>(resolve => setTimeout(resolve, 5));
+        endSecond();
+        endOuter();
+        tracer.mark("done");
+        tracer.mark("done");
+
+        const events: any[] = tracer.toChromeTrace().traceEvents;
+        const tid = (name: string): number => events.find(e => e.name === name).tid;
+        assert.strictEqual(events.length, 5);
+        assert.strictEqual(tid("outer"), tid("nested"));
+        assert.strictEqual(tid("outer"), tid("first"));
+        assert.notStrictEqual(tid("first"), tid("second"));
+        assert.strictEqual(events.find(e => e.name === "done").ph, "i");
+
+        const waterfall: string[] = tracer.toWaterfall().split("\n");
+        assert.strictEqual(waterfall.length, 5);
+        assert.ok(waterfall[0].startsWith("outer "));
+    });
+});
@@ -0,0 +1,38 @@
+/* --------------------------------------------------------------------------------------------
+ * Copyright (c) Microsoft Corporation. All Rights Reserved.
+ * See 'LICENSE' in the project root for license information.
+ * ------------------------------------------------------------------------------------------ */
+import * as assert from "assert";
+import { runWithConcurrencyLimit } from "../../src/Debugger/compoundLaunch";
+
+suite("Compound launch", () => {
+    function delay(ms: number): Promise<void> {
+        return new Promise<void>(resolve => global.setTimeout(resolve, ms));
+    }
+
+    test("Runs at most the limit at once, and returns results in order", async () => {
+        let running: number = 0;
+        let maxRunning: number = 0;
+        const items: number[] = [30, 5, 20, 1, 10, 15, 2, 8];
+        const results: string[] = await runWithConcurrencyLimit(items, 3, async (item: number) => {
+            maxRunning = Math.max(maxRunning, ++running);
+            await delay(item);
+            --running;
+            return `target${item}`;
+        });
+        assert.strictEqual(maxRunning, 3);
+        assert.deepEqual(results, items.map(item => `target${item}`));
+    });
+
+    test("Starts all items at once when the limit allows", async () => {
+        let running: number = 0;
+        let maxRunning: number = 0;
+        await runWithConcurrencyLimit([10, 10, 10, 10], 10, async (item: number) => {
+            maxRunning = Math.max(maxRunning, ++running);
+            await delay(item);
+            --running;
+        });
+        assert.strictEqual(maxRunning, 4);
+        assert.deepEqual(await runWithConcurrencyLimit([], 4, async () => 0), []);
+    });
+});
@@ -0,0 +1,114 @@
+/* --------------------------------------------------------------------------------------------
+ * Copyright (c) Microsoft Corporation. All Rights Reserved.
+ * See 'LICENSE' in the project root for license information.
+ * ------------------------------------------------------------------------------------------ */
+import * as assert from "assert";
+import * as fs from "fs";
+import * as os from "os";
+import * as path from "path";
+import * as vscode from "vscode";
+import { CppDbgConfigurationProvider, ConfigurationAssetProviderFactory, clearResolvedVariablesCache, debugConfigurationCatalog, onDidChangeDebugConfigurationInputs } from "../../src/Debugger/configurationProvider";
+
+suite("Resolved debug configuration variables", () => {
+    const variable: string = "CPPTOOLS_TEST_SOURCE_ROOT";
+    const provider: CppDbgConfigurationProvider = new CppDbgConfigurationProvider(ConfigurationAssetProviderFactory.getConfigurationProvider());
+    const noSettingsChanged: vscode.ConfigurationChangeEvent = { affectsConfiguration: () => false };
+
+    async function resolveSourceFileMap(): Promise<any> {
+        const config: vscode.DebugConfiguration = { type: "cppdbg", name: "test", request: "launch", sourceFileMap: { [`\${env:${variable}}`]: "/target" } };
+        await (<any>provider).resolveEnvFileAndSourceFileMap(config, undefined);
+        return config.sourceFileMap;
+    }
+
+    setup(() => {
+        clearResolvedVariablesCache();
+    });
+
+    teardown(() => {
+        delete process.env[variable];
+    });
+
+    test("Resolved variables are reused", async () => {
+        process.env[variable] = "/a";
+        const first: any = await resolveSourceFileMap();
+        assert.deepStrictEqual(first, { "/a": "/target" });
+        // Changing a resolved configuration doesn't change the cached one.
+        first["/a"] = "/changed";
+        process.env[variable] = "/b";
+        assert.deepStrictEqual(await resolveSourceFileMap(), { "/a": "/target" });
+    });
+
+    test("Resolved variables are cleared when settings change", async () => {
+        process.env[variable] = "/a";
+        assert.deepStrictEqual(await resolveSourceFileMap(), { "/a": "/target" });
+        process.env[variable] = "/b";
+        onDidChangeDebugConfigurationInputs(noSettingsChanged);
+        assert.deepStrictEqual(await resolveSourceFileMap(), { "/b": "/target" });
+    });
+});
+
+suite("Debug configuration catalog", () => {
+    let generateCount: number;
+    let debuggerPath: string;
+
+    // Generates a configuration that uses the debugger if it exists, like the generated configurations do.
+    const generate = async (probedFiles: Map<string, boolean>): Promise<vscode.DebugConfiguration[]> => {
+        ++generateCount;
+        const exists: boolean = fs.existsSync(debuggerPath);
+        probedFiles.set(debuggerPath, exists);
+        return [{ type: "cppdbg", name: "test", request: "launch", miDebuggerPath: exists ? debuggerPath : "/usr/bin/gdb" }];
+    };
+
+    setup(() => {
+        generateCount = 0;
+        debuggerPath = path.join(fs.mkdtempSync(path.join(os.tmpdir(), "catalog")), "gdb");
+        debugConfigurationCatalog.clear();
+    });
+
+    teardown(() => {
+        if (fs.existsSync(debuggerPath)) {
+            fs.unlinkSync(debuggerPath);
+        }
+        fs.rmdirSync(path.dirname(debuggerPath));
+    });
+
+    test("Configurations are reused, as copies", async () => {
+        const first: vscode.DebugConfiguration[] = await debugConfigurationCatalog.get("key", generate);
+        first[0].name = "changed";
+        const second: vscode.DebugConfiguration[] = await debugConfigurationCatalog.get("key", generate);
+        assert.strictEqual(second[0].name, "test");
+        assert.strictEqual(generateCount, 1);
+        await debugConfigurationCatalog.get("other key", generate);
+        assert.strictEqual(generateCount, 2);
+    });
+
+    test("Configurations are generated again when a debugger appears or disappears", async () => {
+        assert.strictEqual((await debugConfigurationCatalog.get("key", generate))[0].miDebuggerPath, "/usr/bin/gdb");
+        fs.writeFileSync(debuggerPath, "");
+        assert.strictEqual((await debugConfigurationCatalog.get("key", generate))[0].miDebuggerPath, debuggerPath);
+        assert.strictEqual(generateCount, 2);
+        await debugConfigurationCatalog.get("key", generate);
+        assert.strictEqual(generateCount, 2);
+        fs.unlinkSync(debuggerPath);
+        assert.strictEqual((await debugConfigurationCatalog.get("key", generate))[0].miDebuggerPath, "/usr/bin/gdb");
+        assert.strictEqual(generateCount, 3);
+    });
+
+    test("Failed generations aren't reused", async () => {
+        await assert.rejects(debugConfigurationCatalog.get("key", async () => { throw new Error("failed"); }));
+        await debugConfigurationCatalog.get("key", generate);
+        assert.strictEqual(generateCount, 1);
+    });
+
+    test("Configurations are cleared when tasks, launch configurations or C/C++ settings change", async () => {
+        await debugConfigurationCatalog.get("key", generate);
+        onDidChangeDebugConfigurationInputs({ affectsConfiguration: (section: string) => section === "editor" });
+        await debugConfigurationCatalog.get("key", generate);
+        assert.strictEqual(generateCount, 1);
+        for (const section of ["tasks", "launch", "C_Cpp"]) {
+            onDidChangeDebugConfigurationInputs({ affectsConfiguration: (changed: string) => changed === section });
+            await debugConfigurationCatalog.get("key", generate);
+        }
+        assert.strictEqual(generateCount, 4);
+    });
+});
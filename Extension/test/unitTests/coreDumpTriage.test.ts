@@ -0,0 +1,76 @@
+/* --------------------------------------------------------------------------------------------
+ * Copyright (c) Microsoft Corporation. All Rights Reserved.
+ * See 'LICENSE' in the project root for license information.
+ * ------------------------------------------------------------------------------------------ */
+import * as assert from "assert";
+import * as child_process from "child_process";
+import { CoreDumpTriageAdapter, getFrameLibraries } from "../../src/Debugger/coreDumpTriage";
+
+suite("Core dump triage", () => {
+    test("Frames are mapped to the libraries they are in", () => {
+        const modules: Map<string, string> = new Map<string, string>([["7", "/usr/lib/libfoo.so"], ["8", "/home/user/prog"]]);
+        const frames: any[] = [
+            { id: 1, name: "libc.so.6!raise()" },
+            { id: 2, name: "helper()", moduleId: 7 },
+            { id: 3, name: "libc.so.6!abort()" },
+            { id: 4, name: "main()", moduleId: 8 },
+            { id: 5, name: "prog!start()" },
+            { id: 6, name: "operator!=()" },
+            { id: 7, name: "libstdc++.so.6!std::terminate()" },
+            { id: 8, name: "unknown()", moduleId: 9 }
+        ];
+        assert.deepEqual(getFrameLibraries(frames, modules, "/home/user/prog"), ["libc.so.6", "libfoo.so", "libstdc++.so.6"]);
+        assert.deepEqual(getFrameLibraries([], modules, "/home/user/prog"), []);
+    });
+
+    test("The first stopped event is held back until symbols are loaded", async () => {
+        // A stand-in for the debug adapter. It reports a module and a stop, returns a stack for stackTrace, and reports
+        // each evaluated expression as output.
+        const script: string = `
+            let seq = 1;
+            let buffer = "";
+            const send = message => {
+                message.seq = seq++;
+                const json = JSON.stringify(message);
+                process.stdout.write("Content-Length: " + Buffer.byteLength(json) + "\\r\\n\\r\\n" + json);
+            };
+            send({ type: "event", event: "module", body: { reason: "new", module: { id: 7, name: "libfoo.so", path: "/usr/lib/libfoo.so" } } });
+            send({ type: "event", event: "stopped", body: { threadId: 3, reason: "exception" } });
+            process.stdin.on("data", data => {
+                buffer += data;
+                for (;;) {
+                    const headerEnd = buffer.indexOf("\\r\\n\\r\\n");
+                    if (headerEnd < 0) {
+                        return;
+                    }
+                    const length = Number(/Content-Length: (\\d+)/.exec(buffer.slice(0, headerEnd))[1]);
+                    const request = JSON.parse(buffer.slice(headerEnd + 4, headerEnd + 4 + length));
+                    buffer = buffer.slice(headerEnd + 4 + length);
+                    let body = {};
+                    if (request.command === "stackTrace") {
+                        body = { stackFrames: [{ id: 1, name: "libc.so.6!raise()" }, { id: 2, name: "helper()", moduleId: 7 }, { id: 3, name: "prog!main()" }] };
+                    } else if (request.command === "evaluate") {
+                        send({ type: "event", event: "output", body: { output: request.arguments.expression } });
+                    }
+                    send({ type: "response", request_seq: request.seq, success: true, command: request.command, body: body });
+                }
+            });`;
+        const child: child_process.ChildProcess = child_process.spawn(process.execPath, ["-e", script], { stdio: "pipe", env: { ...process.env, ELECTRON_RUN_AS_NODE: "1" } });
+        const adapter: CoreDumpTriageAdapter = new CoreDumpTriageAdapter(child, "/home/user/prog");
+        try {
+            const received: string[] = await new Promise<string[]>(resolve => {
+                const messages: string[] = [];
+                adapter.onDidSendMessage((message: any) => {
+                    messages.push(message.type === "event" ? (message.event === "output" ? message.body.output : message.event) : message.command);
+                    if (message.event === "stopped") {
+                        resolve(messages);
+                    }
+                });
+            });
+            // The triage's own requests are not passed on to VS Code, but their output is.
+            assert.deepEqual(received, ["module", "-exec sharedlibrary libc\\.so\\.6", "-exec sharedlibrary libfoo\\.so", "stopped"]);
+        } finally {
+            adapter.dispose();
+        }
+    });
+});
@@ -0,0 +1,71 @@
+/* --------------------------------------------------------------------------------------------
+ * Copyright (c) Microsoft Corporation. All Rights Reserved.
+ * See 'LICENSE' in the project root for license information.
+ * ------------------------------------------------------------------------------------------ */
+import * as assert from "assert";
+import * as child_process from "child_process";
+import * as vscode from "vscode";
+import { ProcessDebugAdapter } from "../../src/Debugger/debugAdapterPool";
+
+suite("Process debug adapter", () => {
+    // Runs a script with the runtime of the test host, which is Electron inside VS Code.
+    function spawnScript(script: string): child_process.ChildProcess {
+        return child_process.spawn(process.execPath, ["-e", script], { stdio: "pipe", env: { ...process.env, ELECTRON_RUN_AS_NODE: "1" } });
+    }
+
+    function receive(adapter: ProcessDebugAdapter, count: number): Promise<any[]> {
+        return new Promise<any[]>(resolve => {
+            const messages: any[] = [];
+            adapter.onDidSendMessage(message => {
+                messages.push(message);
+                if (messages.length === count) {
+                    resolve(messages);
+                }
+            });
+        });
+    }
+
+    test("Messages are framed in both directions", async () => {
+        const adapter: ProcessDebugAdapter = new ProcessDebugAdapter(spawnScript("process.stdin.pipe(process.stdout)"));
+        try {
+            const received: Promise<any[]> = receive(adapter, 2);
+            const messages: vscode.DebugProtocolMessage[] = [
+                <vscode.DebugProtocolMessage>{ seq: 1, type: "request", command: "initialize", arguments: { clientName: "héllo 世界" } },
+                <vscode.DebugProtocolMessage>{ seq: 2, type: "request", command: "next" }
+            ];
+            messages.forEach(message => adapter.handleMessage(message));
+            assert.deepEqual(await received, messages);
+        } finally {
+            adapter.dispose();
+        }
+    });
+
+    test("Messages split across reads are reassembled", async () => {
+        // Writes three messages: the first split in the middle of a multi-byte character, the other two in one write.
+        const script: string = `
+            const json = JSON.stringify({ seq: 1, type: "event", event: "output", body: { output: "\\u00e9\\u00e9\\u00e9" } });
+            const frame = Buffer.from("Content-Length: " + Buffer.byteLength(json) + "\\r\\n\\r\\n" + json);
+            const split = frame.length - 5;
+            process.stdout.write(frame.slice(0, split));
+            setTimeout(() => process.stdout.write(Buffer.concat([frame.slice(split), frame, frame])), 100);
+            setTimeout(() => { }, 5000);`;
+        const adapter: ProcessDebugAdapter = new ProcessDebugAdapter(spawnScript(script));
+        try {
+            const messages: any[] = await receive(adapter, 3);
+            messages.forEach(message => assert.strictEqual(message.body.output, "ééé"));
+        } finally {
+            adapter.dispose();
+        }
+    });
+
+    test("Messages sent after the adapter exits are ignored", async () => {
+        const adapter: ProcessDebugAdapter = new ProcessDebugAdapter(spawnScript("process.exit(0)"));
+        try {
+            const messages: any[] = await receive(adapter, 1);
+            assert.strictEqual(messages[0].event, "terminated");
+            adapter.handleMessage(<vscode.DebugProtocolMessage>{ seq: 1, type: "request", command: "disconnect" });
+        } finally {
+            adapter.dispose();
+        }
+    });
+});
@@ -0,0 +1,47 @@
+/* --------------------------------------------------------------------------------------------
+ * Copyright (c) Microsoft Corporation. All Rights Reserved.
+ * See 'LICENSE' in the project root for license information.
+ * ------------------------------------------------------------------------------------------ */
+import * as assert from "assert";
+import * as fs from "fs";
+import * as os from "os";
+import * as path from "path";
+import { DirectoryFormatConfig, getDirectoryFormatConfig, invalidateFormatConfig, preloadDirectoryFormatConfigs } from "../../src/LanguageServer/editorConfigCache";
+
+suite("Formatting configuration cache", () => {
+    let dirPath: string;
+    let editorConfigPath: string;
+
+    setup(() => {
+        dirPath = fs.mkdtempSync(path.join(os.tmpdir(), "editorConfigCache-"));
+        editorConfigPath = path.join(dirPath, ".editorconfig");
+        fs.writeFileSync(editorConfigPath, "root = true\nindent_size = 2\n");
+    });
+
+    teardown(() => {
+        fs.unlinkSync(editorConfigPath);
+        fs.rmdirSync(dirPath);
+    });
+
+    test("Preloaded files are used by later lookups", async () => {
+        await preloadDirectoryFormatConfigs(path.join(dirPath, "file.cpp"));
+        fs.writeFileSync(editorConfigPath, "root = true\nindent_size = 4\n");
+        // Not invalidated, so the preloaded contents are still used.
+        assert.strictEqual(getDirectoryFormatConfig(dirPath).editorConfigContents, "root = true\nindent_size = 2\n");
+        invalidateFormatConfig(editorConfigPath);
+        assert.strictEqual(getDirectoryFormatConfig(dirPath).editorConfigContents, "root = true\nindent_size = 4\n");
+        invalidateFormatConfig(editorConfigPath);
+    });
+
+    test("A preload that is interrupted by a change doesn't cache what it read", async () => {
+        const preload: Promise<void> = preloadDirectoryFormatConfigs(path.join(dirPath, "file.cpp"));
+        invalidateFormatConfig(editorConfigPath);
+        await preload;
+        // What the preload read may be older than the change, so the next lookup reads the file again.
+        fs.writeFileSync(editorConfigPath, "root = true\nindent_size = 4\n");
+        const config: DirectoryFormatConfig = getDirectoryFormatConfig(dirPath);
+        assert.strictEqual(config.editorConfigContents, "root = true\nindent_size = 4\n");
+        assert.ok(config.editorConfigIsRoot);
+        invalidateFormatConfig(editorConfigPath);
+    });
+});
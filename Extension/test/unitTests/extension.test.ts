@@ -6,7 +6,8 @@
 import * as assert from 'assert';
 import * as os from 'os';
 import { LinuxDistribution } from '../../src/linuxDistribution';
-import { Process, WmicProcessParser, PsProcessParser } from '../../src/Debugger/nativeAttach';
+import { Process, WmicProcessParser, PsProcessParser, PsAttachItemsProvider, ProcFsAttachItemsProvider, ProcessTable, sortProcessesByName } from '../../src/Debugger/nativeAttach';
+import { AttachItem } from '../../src/Debugger/attachQuickPick';
 
 suite("LinuxDistro Tests", () => {
     test("Parse valid os-release file", () => {
@@ -125,4 +126,80 @@ suite("Pick Process Tests", () => {
         assert.equal(process2.name, 'mdworker');
         assert.equal(process2.pid, '15220');
     });
+
+    test("Sort processes by name", () => {
+        const processes: Process[] = [new Process("beta", "1"), new Process(undefined as any, "2"), new Process("Alpha", "3"), new Process("alpha", "4")];
+        assert.deepEqual(sortProcessesByName(processes).map(p => p.pid), ["3", "4", "1", "2"]);
+    });
+
+    test("Process table applies differences", () => {
+        const table: ProcessTable = new ProcessTable();
+        assert.ok(table.update([new Process("b", "1", "b"), new Process("a", "2", "a")]));
+        const items: AttachItem[] = table.Items;
+        assert.deepEqual(items.map(item => item.id), ["2", "1"]);
+
+        // Nothing changed: the same list is kept.
+        assert.ok(!table.update([new Process("a", "2", "a"), new Process("b", "1", "b")]));
+        assert.strictEqual(table.Items, items);
+
+        // Unchanged processes keep their items.
+        assert.ok(table.update([new Process("a", "2", "a"), new Process("c", "3", "c")]));
+        assert.deepEqual(table.Items.map(item => item.id), ["2", "3"]);
+        assert.strictEqual(table.Items[0], items[0]);
+
+        // A reused process id with a different command line gets a new item.
+        assert.ok(table.update([new Process("a", "2", "a --flag"), new Process("c", "3", "c")]));
+        assert.notStrictEqual(table.Items[0], items[0]);
+    });
+
+    test("Partial results are sorted by name", async () => {
+        class TestAttachItemsProvider extends PsAttachItemsProvider {
+            protected async getInternalProcessEntries(onPartialResult?: (processes: Process[]) => void): Promise<Process[]> {
+                const processes: Process[] = [new Process("b", "1", "b"), new Process("a", "2", "a")];
+                if (onPartialResult) {
+                    onPartialResult(processes.slice(0, 1));
+                    onPartialResult(processes);
+                }
+                return processes;
+            }
+        }
+        const partialResults: string[][] = [];
+        const items: AttachItem[] = await new TestAttachItemsProvider().getAttachItems(partialItems => partialResults.push(partialItems.map(item => item.label)));
+        assert.deepEqual(partialResults, [["b"], ["a", "b"]]);
+        assert.deepEqual(items.map(item => item.label), ["a", "b"]);
+    });
+
+    test("/proc and ps process enumeration agree", async function (): Promise<void> {
+        if (os.platform() !== 'linux') {
+            this.skip();
+        }
+        const psItems: AttachItem[] = await new PsAttachItemsProvider().getAttachItems();
+        const procFsItems: AttachItem[] = await new ProcFsAttachItemsProvider().getAttachItems();
+        // Processes may start or exit between the two enumerations.
+        assert.ok(Math.abs(psItems.length - procFsItems.length) <= Math.max(10, psItems.length / 10));
+        const self: AttachItem | undefined = procFsItems.find(item => item.id === process.pid.toString());
+        const psSelf: AttachItem | undefined = psItems.find(item => item.id === process.pid.toString());
+        assert.ok(self);
+        assert.ok(psSelf);
+        assert.strictEqual((<AttachItem>self).label, (<AttachItem>psSelf).label);
+
+        const filteredItems: AttachItem[] = await new ProcFsAttachItemsProvider().getAttachItems(undefined, { name: (<AttachItem>self).label, user: os.userInfo().username });
+        assert.ok(filteredItems.length < procFsItems.length);
+        assert.ok(filteredItems.some(item => item.id === process.pid.toString()));
+    });
+
+    test("Benchmark: ps vs. /proc process enumeration", async function (): Promise<void> {
+        if (os.platform() !== 'linux') {
+            this.skip();
+        }
+        let start: number = Date.now();
+        const psItems: AttachItem[] = await new PsAttachItemsProvider().getAttachItems();
+        const psTime: number = Date.now() - start;
+        start = Date.now();
+        let partialResults: number = 0;
+        const procFsItems: AttachItem[] = await new ProcFsAttachItemsProvider().getAttachItems(() => ++partialResults);
+        const procFsTime: number = Date.now() - start;
+        console.log(`    Enumerated processes: ps ${psTime} ms, ${psItems.length} processes;`
+            + ` /proc ${procFsTime} ms, ${procFsItems.length} processes, ${partialResults} partial results.`);
+    });
 });
@@ -0,0 +1,91 @@
+/* --------------------------------------------------------------------------------------------
+ * Copyright (c) Microsoft Corporation. All Rights Reserved.
+ * See 'LICENSE' in the project root for license information.
+ * ------------------------------------------------------------------------------------------ */
+import * as assert from "assert";
+import * as vscode from "vscode";
+import { DefaultClient, FoldingRangeKind, GetFoldingRangesResult } from "../../src/LanguageServer/client";
+import { FoldingRangeProvider } from "../../src/LanguageServer/Providers/foldingRangeProvider";
+
+suite("Folding range cache", () => {
+    const uri: vscode.Uri = vscode.Uri.file("/src/project/file.cpp");
+    const token: vscode.CancellationToken = new vscode.CancellationTokenSource().token;
+    const context: vscode.FoldingContext = {};
+    let requestCount: number;
+    // The response to the next request, and a callback run while it is pending.
+    let nextResult: GetFoldingRangesResult;
+    let whilePending: (() => void) | undefined;
+    let provider: FoldingRangeProvider;
+
+    setup(() => {
+        requestCount = 0;
+        nextResult = { canceled: false, ranges: [{ kind: FoldingRangeKind.None, range: { startLine: 1, endLine: 3 } }] };
+        whilePending = undefined;
+        const client: any = {
+            awaitUntilLanguageClientReady: async () => { },
+            abortRequest: () => { },
+            languageClient: {
+                sendRequest: async () => {
+                    ++requestCount;
+                    if (whilePending) {
+                        whilePending();
+                    }
+                    return nextResult;
+                }
+            }
+        };
+        provider = new FoldingRangeProvider(<DefaultClient>client);
+    });
+
+    function makeDocument(version: number): vscode.TextDocument {
+        return <vscode.TextDocument><unknown>{ uri: uri, version: version };
+    }
+
+    test("Results are reused until the document changes", async () => {
+        const ranges: vscode.FoldingRange[] | undefined = await provider.provideFoldingRanges(makeDocument(1), context, token);
+        assert.deepEqual(ranges, [{ start: 1, end: 3 }]);
+        assert.strictEqual(await provider.provideFoldingRanges(makeDocument(1), context, token), ranges);
+        assert.strictEqual(requestCount, 1);
+        await provider.provideFoldingRanges(makeDocument(2), context, token);
+        assert.strictEqual(requestCount, 2);
+    });
+
+    test("Results for another version of the document aren't cached", async () => {
+        nextResult.fileVersion = 1;
+        await provider.provideFoldingRanges(makeDocument(2), context, token);
+        await provider.provideFoldingRanges(makeDocument(2), context, token);
+        assert.strictEqual(requestCount, 2);
+        nextResult.fileVersion = 2;
+        await provider.provideFoldingRanges(makeDocument(2), context, token);
+        await provider.provideFoldingRanges(makeDocument(2), context, token);
+        assert.strictEqual(requestCount, 3);
+    });
+
+    test("Results of requests that an invalidation interrupts aren't cached", async () => {
+        whilePending = () => provider.invalidateFile(uri.toString());
+        await provider.provideFoldingRanges(makeDocument(1), context, token);
+        whilePending = undefined;
+        await provider.provideFoldingRanges(makeDocument(1), context, token);
+        await provider.provideFoldingRanges(makeDocument(1), context, token);
+        assert.strictEqual(requestCount, 2);
+    });
+
+    test("Only changed inactive regions invalidate the cache", async () => {
+        const regions: { startLine: number; endLine: number }[] = [{ startLine: 5, endLine: 7 }];
+        provider.updateInactiveRegions(uri.toString(), regions, 1);
+        await provider.provideFoldingRanges(makeDocument(1), context, token);
+
+        provider.updateInactiveRegions(uri.toString(), [{ startLine: 5, endLine: 7 }], 1);
+        await provider.provideFoldingRanges(makeDocument(1), context, token);
+        assert.strictEqual(requestCount, 1);
+
+        provider.updateInactiveRegions(uri.toString(), [{ startLine: 5, endLine: 8 }], 1);
+        await provider.provideFoldingRanges(makeDocument(1), context, token);
+        assert.strictEqual(requestCount, 2);
+
+        // The same regions for a different version than the cached ranges.
+        provider.updateInactiveRegions(uri.toString(), [{ startLine: 5, endLine: 8 }], 2);
+        await provider.provideFoldingRanges(makeDocument(1), context, token);
+        assert.strictEqual(requestCount, 3);
+    });
+});
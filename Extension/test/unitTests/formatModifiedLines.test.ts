@@ -0,0 +1,97 @@
+/* --------------------------------------------------------------------------------------------
+ * Copyright (c) Microsoft Corporation. All Rights Reserved.
+ * See 'LICENSE' in the project root for license information.
+ * ------------------------------------------------------------------------------------------ */
+import * as assert from "assert";
+import * as vscode from "vscode";
+import { LineRange, ModifiedLinesTracker } from "../../src/LanguageServer/modifiedLinesTracker";
+import { dropOverlappingEdits, makeMinimalTextEdit, mergeNearbyLineRanges } from "../../src/LanguageServer/Providers/documentFormattingEditProvider";
+
+suite("Format modified lines", () => {
+    const uri: vscode.Uri = vscode.Uri.file("/src/project/file.cpp");
+    const document: vscode.TextDocument = <vscode.TextDocument><unknown>{ uri: uri, isDirty: true };
+    let tracker: ModifiedLinesTracker;
+
+    setup(() => {
+        tracker = new ModifiedLinesTracker();
+    });
+
+    teardown(() => {
+        tracker.dispose();
+    });
+
+    function change(...changes: [number, number, number, number, string][]): void {
+        tracker.onDidChangeTextDocument(<vscode.TextDocumentChangeEvent><unknown>{
+            document: document,
+            contentChanges: changes.map(c => ({ range: new vscode.Range(c[0], c[1], c[2], c[3]), text: c[4] }))
+        });
+    }
+
+    test("Changed lines are tracked", () => {
+        change([2, 0, 2, 0, "a\nb"]);
+        assert.deepEqual(tracker.getModifiedLines(document), [{ startLine: 2, endLine: 3 }]);
+        change([10, 4, 10, 4, "x"]);
+        assert.deepEqual(tracker.getModifiedLines(document), [{ startLine: 2, endLine: 3 }, { startLine: 10, endLine: 10 }]);
+        // Adjacent changes are merged.
+        change([4, 0, 4, 1, "y"]);
+        assert.deepEqual(tracker.getModifiedLines(document), [{ startLine: 2, endLine: 4 }, { startLine: 10, endLine: 10 }]);
+    });
+
+    test("Later ranges move when lines are added or deleted", () => {
+        change([10, 0, 10, 1, "x"]);
+        change([2, 0, 2, 0, "a\r\nb\r\n"]);
+        assert.deepEqual(tracker.getModifiedLines(document), [{ startLine: 2, endLine: 4 }, { startLine: 12, endLine: 12 }]);
+        // Deleting lines 6 to 8.
+        change([6, 0, 9, 0, ""]);
+        assert.deepEqual(tracker.getModifiedLines(document), [{ startLine: 2, endLine: 4 }, { startLine: 6, endLine: 6 }, { startLine: 9, endLine: 9 }]);
+    });
+
+    test("Changes in one event are relative to the document before the event", () => {
+        change([1, 0, 1, 0, "a\n"], [5, 0, 5, 0, "b"]);
+        assert.deepEqual(tracker.getModifiedLines(document), [{ startLine: 1, endLine: 2 }, { startLine: 6, endLine: 6 }]);
+    });
+
+    test("Saved and clean documents have no modified lines", () => {
+        change([1, 0, 1, 0, "a"]);
+        assert.strictEqual(tracker.getModifiedLines(<vscode.TextDocument><unknown>{ uri: uri, isDirty: false }), undefined);
+        tracker.removeFile(uri.toString());
+        assert.strictEqual(tracker.getModifiedLines(document), undefined);
+    });
+
+    test("Nearby ranges are merged", () => {
+        const ranges: LineRange[] = [{ startLine: 0, endLine: 1 }, { startLine: 2, endLine: 2 }, { startLine: 5, endLine: 6 }, { startLine: 10, endLine: 12 }];
+        assert.deepEqual(mergeNearbyLineRanges(ranges), [{ startLine: 0, endLine: 6 }, { startLine: 10, endLine: 12 }]);
+        // The input isn't modified.
+        assert.deepEqual(ranges[0], { startLine: 0, endLine: 1 });
+        assert.deepEqual(mergeNearbyLineRanges([]), []);
+    });
+
+    test("Overlapping edits are dropped", () => {
+        const edit = (startLine: number, startCharacter: number, endLine: number, endCharacter: number): any =>
+            ({ range: { start: { line: startLine, character: startCharacter }, end: { line: endLine, character: endCharacter } }, newText: "" });
+        const first: any = edit(1, 0, 2, 4);
+        const overlapping: any = edit(2, 2, 3, 0);
+        const adjacent: any = edit(2, 4, 2, 6);
+        const later: any = edit(5, 0, 5, 1);
+        const dropped: any[] = [];
+        assert.deepEqual(dropOverlappingEdits([later, overlapping, adjacent, first], e => dropped.push(e)), [first, adjacent, later]);
+        assert.deepEqual(dropped, [overlapping]);
+    });
+
+    test("Formatting edits only replace the text that changes", async () => {
+        const lf: vscode.TextDocument = await vscode.workspace.openTextDocument({ language: "cpp", content: "int  x;\nint y;\n" });
+        assert.strictEqual(makeMinimalTextEdit(lf, new vscode.Range(0, 0, 2, 0), "int  x;\nint y;\n"), undefined);
+        const edit: vscode.TextEdit | undefined = makeMinimalTextEdit(lf, new vscode.Range(0, 0, 2, 0), "int x;\nint y;\n");
+        assert.ok(edit);
+        assert.ok((<vscode.TextEdit>edit).range.isEqual(new vscode.Range(0, 4, 0, 5)));
+        assert.strictEqual((<vscode.TextEdit>edit).newText, "");
+    });
+
+    test("Formatting edits don't split CRLF line breaks", async () => {
+        const crlf: vscode.TextDocument = await vscode.workspace.openTextDocument({ language: "cpp", content: "a\r\n" });
+        const edit: vscode.TextEdit | undefined = makeMinimalTextEdit(crlf, new vscode.Range(0, 0, 1, 0), "a\r\r\n");
+        assert.ok(edit);
+        assert.ok((<vscode.TextEdit>edit).range.isEqual(new vscode.Range(0, 1, 1, 0)));
+        assert.strictEqual((<vscode.TextEdit>edit).newText, "\r\r\n");
+    });
+});
@@ -0,0 +1,73 @@
+/* --------------------------------------------------------------------------------------------
+ * Copyright (c) Microsoft Corporation. All Rights Reserved.
+ * See 'LICENSE' in the project root for license information.
+ * ------------------------------------------------------------------------------------------ */
+import * as assert from "assert";
+import * as vscode from "vscode";
+import { UriInternTable, makeVscodeLineRange, makeVscodeLocation } from "../../src/LanguageServer/Providers/internTable";
+
+suite("Provider result intern table", () => {
+    const fileCount: number = 50;
+    const referenceCount: number = 20000;
+    const uris: string[] = [];
+    for (let i: number = 0; i < referenceCount; ++i) {
+        uris.push(vscode.Uri.file(`/src/project/module${i % fileCount}/file${i % fileCount}.cpp`).toString());
+    }
+
+    test("Interned URIs are equivalent to parsed URIs", () => {
+        const table: UriInternTable = new UriInternTable();
+        const uri: string = uris[0];
+        assert.strictEqual(table.parse(uri).toString(), vscode.Uri.parse(uri).toString());
+        assert.strictEqual(table.parse(uri), table.parse(uri));
+        assert.strictEqual(table.file("/src/a.cpp").fsPath, vscode.Uri.file("/src/a.cpp").fsPath);
+        assert.strictEqual(table.file("/src/a.cpp"), table.file("/src/a.cpp"));
+    });
+
+    test("Locations share one URI object per file", () => {
+        const uriObjects: Set<vscode.Uri> = new Set<vscode.Uri>();
+        for (const uri of uris) {
+            const location: vscode.Location = makeVscodeLocation(uri, { start: { line: 1, character: 2 }, end: { line: 1, character: 5 } });
+            uriObjects.add(location.uri);
+        }
+        assert.strictEqual(uriObjects.size, fileCount);
+    });
+
+    test("Benchmark: interned vs. uncached URI decoding", () => {
+        const table: UriInternTable = new UriInternTable();
+        let heapStart: number = process.memoryUsage().heapUsed;
+        let start: number = Date.now();
+        const parsed: vscode.Uri[] = uris.map(uri => vscode.Uri.parse(uri));
+        const parseTime: number = Date.now() - start;
+        const parseHeap: number = process.memoryUsage().heapUsed - heapStart;
+        heapStart = process.memoryUsage().heapUsed;
+        start = Date.now();
+        const interned: vscode.Uri[] = uris.map(uri => table.parse(uri));
+        const internTime: number = Date.now() - start;
+        const internHeap: number = process.memoryUsage().heapUsed - heapStart;
+        console.log(`    Decoded ${referenceCount} URIs of ${fileCount} files: Uri.parse ${parseTime} ms, ${new Set<vscode.Uri>(parsed).size} objects, ~${Math.round(parseHeap / 1024)} KB;`
+            + ` interned ${internTime} ms, ${new Set<vscode.Uri>(interned).size} objects, ~${Math.round(internHeap / 1024)} KB.`);
+        assert.strictEqual(new Set<vscode.Uri>(interned).size, fileCount);
+        assert.strictEqual(table.size, fileCount);
+    });
+
+    test("The table is bounded", () => {
+        const table: UriInternTable = new UriInternTable();
+        const first: vscode.Uri = table.file("/src/file0.cpp");
+        for (let i: number = 1; i <= 20000; ++i) {
+            table.file(`/src/file${i}.cpp`);
+        }
+        assert.ok(table.size <= 20000);
+        // Entries that were dropped are created again, and are still equivalent.
+        assert.strictEqual(table.file("/src/file0.cpp").fsPath, first.fsPath);
+        table.clear();
+        assert.strictEqual(table.size, 0);
+    });
+
+    test("Line ranges", () => {
+        const range: vscode.Range = makeVscodeLineRange(3, 4, 5);
+        assert.ok(range.isEqual(new vscode.Range(3, 4, 3, 9)));
+        const empty: vscode.Range = makeVscodeLineRange(3, 4, 0);
+        assert.ok(empty.isEmpty);
+        assert.ok(empty.start.isEqual(new vscode.Position(3, 4)));
+    });
+});
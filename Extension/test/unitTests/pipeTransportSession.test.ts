@@ -0,0 +1,123 @@
+/* --------------------------------------------------------------------------------------------
+ * Copyright (c) Microsoft Corporation. All Rights Reserved.
+ * See 'LICENSE' in the project root for license information.
+ * ------------------------------------------------------------------------------------------ */
+import * as assert from "assert";
+import * as fs from "fs";
+import * as os from "os";
+import * as path from "path";
+import { PipeTransportSession } from "../../src/Debugger/pipeTransportSession";
+import { RemoteAttachPicker } from "../../src/Debugger/attachToProcess";
+import { AttachItem } from "../../src/Debugger/attachQuickPick";
+
+suite("Pipe transport session", function (): void {
+    let tempDir: string;
+    let connectionLog: string;
+    let pipeCmd: string;
+
+    suiteSetup(function (): void {
+        if (os.platform() === "win32") {
+            this.skip();
+        }
+        // A stand-in for ssh: it records each connection and runs the "remote" command locally.
+        tempDir = fs.mkdtempSync(path.join(os.tmpdir(), "pipeTransport"));
+        connectionLog = path.join(tempDir, "connections.log");
+        const script: string = path.join(tempDir, "fake-ssh.sh");
+        fs.writeFileSync(script, `#!/bin/sh\necho connected >> "${connectionLog}"\nshift\nexec "$@"\n`);
+        fs.chmodSync(script, 0o755);
+        pipeCmd = `"${script}" "user@host"`;
+    });
+
+    setup(() => {
+        if (connectionLog && fs.existsSync(connectionLog)) {
+            fs.unlinkSync(connectionLog);
+        }
+    });
+
+    function connectionCount(): number {
+        return fs.existsSync(connectionLog) ? fs.readFileSync(connectionLog, "utf8").split("\n").filter(line => line).length : 0;
+    }
+
+    test("Commands share one connection", async () => {
+        const session: PipeTransportSession = new PipeTransportSession(pipeCmd);
+        try {
+            assert.strictEqual(await session.getRemoteOS(), os.type());
+            assert.strictEqual(await session.getRemoteOS(), os.type());
+            for (let i: number = 0; i < 3; ++i) {
+                const lines: string[] = [];
+                await session.run("echo one; echo two", line => lines.push(line));
+                assert.deepEqual(lines, ["one", "two"]);
+            }
+            assert.strictEqual(connectionCount(), 1);
+        } finally {
+            session.dispose();
+        }
+    });
+
+    test("Concurrent commands are run in order", async () => {
+        const session: PipeTransportSession = new PipeTransportSession(pipeCmd);
+        try {
+            const lines: string[][] = [[], [], []];
+            await Promise.all(lines.map((output, i) => session.run(`echo ${i}; echo ${i}`, line => output.push(line))));
+            assert.deepEqual(lines, [["0", "0"], ["1", "1"], ["2", "2"]]);
+        } finally {
+            session.dispose();
+        }
+    });
+
+    test("Output that doesn't end with a newline", async () => {
+        const session: PipeTransportSession = new PipeTransportSession(pipeCmd);
+        try {
+            const outputs: string[][] = [];
+            for (const command of ["printf abc", "printf 'a\\n\\n'", "true"]) {
+                const lines: string[] = [];
+                await session.run(command, line => lines.push(line));
+                outputs.push(lines);
+            }
+            assert.deepEqual(outputs, [["abc"], ["a", ""], []]);
+        } finally {
+            session.dispose();
+        }
+    });
+
+    test("Failed commands are reported and the session can be reused", async () => {
+        const session: PipeTransportSession = new PipeTransportSession(pipeCmd);
+        try {
+            await assert.rejects(session.run("echo error >&2; false", () => { }), /error/);
+            const lines: string[] = [];
+            await session.run("echo ok", line => lines.push(line));
+            assert.deepEqual(lines, ["ok"]);
+            assert.ok(session.isAlive);
+        } finally {
+            session.dispose();
+        }
+    });
+
+    test("Lost connections are reported", async () => {
+        const session: PipeTransportSession = new PipeTransportSession(pipeCmd);
+        await assert.rejects(session.run("exit 3", () => { }));
+        assert.ok(!session.isAlive);
+        assert.ok(!session.isStdinClosed);
+        await assert.rejects(session.run("echo ok", () => { }));
+    });
+
+    test("Pipe programs that don't forward stdin are detected", async () => {
+        const session: PipeTransportSession = new PipeTransportSession(`${pipeCmd} < /dev/null`);
+        await assert.rejects(session.run("echo ok", () => { }));
+        assert.ok(session.isStdinClosed);
+    });
+
+    test("Remote attaches reuse the connection", async () => {
+        const picker: RemoteAttachPicker = new RemoteAttachPicker();
+        try {
+            const getRemoteOSAndProcesses: (pipeCmd: string) => Promise<AttachItem[]> = (<any>picker).getRemoteOSAndProcesses.bind(picker);
+            for (let i: number = 0; i < 2; ++i) {
+                const items: AttachItem[] = await getRemoteOSAndProcesses(pipeCmd);
+                assert.ok(items.some(item => item.id === process.pid.toString()));
+            }
+            assert.strictEqual(connectionCount(), 1);
+        } finally {
+            picker.dispose();
+        }
+    });
+});
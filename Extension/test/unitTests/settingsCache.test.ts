@@ -0,0 +1,70 @@
+/* --------------------------------------------------------------------------------------------
+ * Copyright (c) Microsoft Corporation. All Rights Reserved.
+ * See 'LICENSE' in the project root for license information.
+ * ------------------------------------------------------------------------------------------ */
+import * as assert from "assert";
+import * as vscode from "vscode";
+import { CppSettings, getCachedConfiguration } from "../../src/LanguageServer/settings";
+
+suite("Settings snapshot cache", () => {
+    const resource: vscode.Uri = vscode.Uri.file("/src/project/file.cpp");
+
+    test("Cached settings match the current configuration", () => {
+        assert.strictEqual(getCachedConfiguration("C_Cpp", resource), getCachedConfiguration("C_Cpp", resource));
+        assert.strictEqual(new CppSettings(resource).formattingEngine, vscode.workspace.getConfiguration("C_Cpp", resource).get<string>("formatting"));
+        assert.strictEqual(getCachedConfiguration("files", resource, "cpp").get<string>("encoding"),
+            vscode.workspace.getConfiguration("files", { uri: resource, languageId: "cpp" }).get<string>("encoding"));
+    });
+
+    test("Snapshots are cached per section, workspace folder and language", () => {
+        // Files outside of the workspace folders share the workspace's snapshot.
+        const outside: vscode.Uri = vscode.Uri.file("/src/project/other.cpp");
+        if (!vscode.workspace.getWorkspaceFolder(resource) && !vscode.workspace.getWorkspaceFolder(outside)) {
+            assert.strictEqual(getCachedConfiguration("C_Cpp", resource), getCachedConfiguration("C_Cpp", outside));
+            assert.strictEqual(getCachedConfiguration("C_Cpp", resource), getCachedConfiguration("C_Cpp"));
+        }
+        // Files in the same folder share the folder's snapshot.
+        const folders: readonly vscode.WorkspaceFolder[] = vscode.workspace.workspaceFolders ?? [];
+        for (const folder of folders) {
+            assert.strictEqual(getCachedConfiguration("C_Cpp", vscode.Uri.joinPath(folder.uri, "a.cpp")),
+                getCachedConfiguration("C_Cpp", vscode.Uri.joinPath(folder.uri, "b", "c.cpp")));
+        }
+        assert.notStrictEqual(getCachedConfiguration("C_Cpp", resource), getCachedConfiguration("files", resource));
+        assert.notStrictEqual(getCachedConfiguration("files", resource, "cpp"), getCachedConfiguration("files", resource, "c"));
+    });
+
+    test("A configuration change is seen by the next read", async () => {
+        const configuration: vscode.WorkspaceConfiguration = vscode.workspace.getConfiguration("C_Cpp");
+        const inspected: { globalValue?: string } | undefined = configuration.inspect<string>("formatting");
+        const original: string | undefined = inspected ? inspected.globalValue : undefined;
+        const before: vscode.WorkspaceConfiguration = getCachedConfiguration("C_Cpp", resource);
+        const changed: string = new CppSettings(resource).formattingEngine === "vcFormat" ? "clangFormat" : "vcFormat";
+        try {
+            await configuration.update("formatting", changed, vscode.ConfigurationTarget.Global);
+            assert.notStrictEqual(getCachedConfiguration("C_Cpp", resource), before);
+            assert.strictEqual(new CppSettings(resource).formattingEngine, changed);
+        } finally {
+            await configuration.update("formatting", original, vscode.ConfigurationTarget.Global);
+        }
+    });
+});
+
+suite("Settings snapshot cache benchmark", () => {
+    const resource: vscode.Uri = vscode.Uri.file("/src/project/file.cpp");
+
+    test("Benchmark: settings reads per event", () => {
+        const eventCount: number = 10000;
+        let start: number = Date.now();
+        for (let i: number = 0; i < eventCount; ++i) {
+            vscode.workspace.getConfiguration("C_Cpp", resource).get<string>("formatting");
+        }
+        const uncachedTime: number = Date.now() - start;
+        start = Date.now();
+        for (let i: number = 0; i < eventCount; ++i) {
+            assert.ok(new CppSettings(resource).formattingEngine !== undefined);
+        }
+        const cachedTime: number = Date.now() - start;
+        console.log(`    ${eventCount} settings reads: getConfiguration ${uncachedTime} ms (${(uncachedTime * 1000 / eventCount).toFixed(1)} us/event);`
+            + ` cached CppSettings ${cachedTime} ms (${(cachedTime * 1000 / eventCount).toFixed(1)} us/event).`);
+    });
+});
@@ -0,0 +1,38 @@
+/* --------------------------------------------------------------------------------------------
+ * Copyright (c) Microsoft Corporation. All Rights Reserved.
+ * See 'LICENSE' in the project root for license information.
+ * ------------------------------------------------------------------------------------------ */
+import * as assert from "assert";
+import { computeSettingsDelta, SettingsSyncState, SettingsUpdate } from "../../src/LanguageServer/settingsDelta";
+
+suite("Settings delta synchronization", () => {
+    const settings: any = {
+        C_Cpp: { autocomplete: "Default", vcFormat: { indent: { braces: false } }, files: { exclude: { "**/.git": true } } },
+        files: { associations: { "*.h": "cpp" } },
+        workspace_fallback_encoding: "utf8"
+    };
+
+    test("Only changed keys are included in a delta", () => {
+        const current: any = JSON.parse(JSON.stringify(settings));
+        assert.strictEqual(computeSettingsDelta(settings, current), undefined);
+
+        current.C_Cpp.vcFormat.indent.braces = true;
+        current.files.associations["*.inl"] = "cpp";
+        delete current.C_Cpp.files.exclude["**/.git"];
+        assert.deepStrictEqual(computeSettingsDelta(settings, current), {
+            C_Cpp: { vcFormat: { indent: { braces: true } }, files: { exclude: { "**/.git": null } } },
+            files: { associations: { "*.inl": "cpp" } }
+        });
+    });
+
+    test("Unchanged settings are not sent again", () => {
+        const state: SettingsSyncState = new SettingsSyncState();
+        const first: SettingsUpdate | undefined = state.getUpdate(settings, true);
+        assert.deepStrictEqual(first, { settings: settings, settingsVersion: 1, isDelta: false });
+        assert.strictEqual(state.getUpdate(settings, true), undefined);
+
+        const changed: any = { ...settings, workspace_fallback_encoding: "utf16le" };
+        assert.deepStrictEqual(state.getUpdate(changed, true), { settings: { workspace_fallback_encoding: "utf16le" }, settingsVersion: 2, isDelta: true });
+        assert.deepStrictEqual(state.getUpdate(settings, false), { settings: settings, settingsVersion: 3, isDelta: false });
+    });
+});
@@ -0,0 +1,63 @@
+/* --------------------------------------------------------------------------------------------
+ * Copyright (c) Microsoft Corporation. All Rights Reserved.
+ * See 'LICENSE' in the project root for license information.
+ * ------------------------------------------------------------------------------------------ */
+import * as assert from "assert";
+import * as vscode from "vscode";
+import { SettingsTracker } from "../../src/LanguageServer/settingsTracker";
+
+suite("SettingsTracker change detection", () => {
+    async function withGlobalSetting(section: string, value: any, callback: () => void): Promise<void> {
+        const configuration: vscode.WorkspaceConfiguration = vscode.workspace.getConfiguration("C_Cpp");
+        const inspected: { globalValue?: any } | undefined = configuration.inspect(section);
+        const original: any = inspected ? inspected.globalValue : undefined;
+        try {
+            await configuration.update(section, value, vscode.ConfigurationTarget.Global);
+            callback();
+        } finally {
+            await configuration.update(section, original, vscode.ConfigurationTarget.Global);
+        }
+    }
+
+    test("Unchanged settings are not reported", () => {
+        const tracker: SettingsTracker = new SettingsTracker(undefined);
+        assert.deepStrictEqual(tracker.getChangedSettings(), {});
+        assert.deepStrictEqual(tracker.getChangedSettings(), {});
+    });
+
+    test("A changed setting is reported", async () => {
+        const tracker: SettingsTracker = new SettingsTracker(undefined);
+        const changed: string = vscode.workspace.getConfiguration("C_Cpp").get<string>("autocomplete") === "Disabled" ? "Default" : "Disabled";
+        await withGlobalSetting("autocomplete", changed, () => {
+            assert.deepStrictEqual(tracker.getChangedSettings(), { autocomplete: changed });
+            assert.deepStrictEqual(tracker.getChangedSettings(), {});
+        });
+        assert.ok(tracker.getChangedSettings().autocomplete !== undefined);
+    });
+
+    test("A changed sub-setting is reported, and its unchanged siblings are not", async () => {
+        const tracker: SettingsTracker = new SettingsTracker(undefined);
+        const changed: boolean = !vscode.workspace.getConfiguration("C_Cpp").get<boolean>("vcFormat.indent.braces");
+        await withGlobalSetting("vcFormat.indent.braces", changed, () => {
+            assert.deepStrictEqual(tracker.getChangedSettings(), { "vcFormat.indent.braces": String(changed) });
+            assert.deepStrictEqual(tracker.getChangedSettings(), {});
+        });
+        assert.deepStrictEqual(tracker.getChangedSettings(), { "vcFormat.indent.braces": String(!changed) });
+    });
+});
+
+suite("SettingsTracker benchmark", () => {
+    test("Benchmark: unchanged settings are skipped", () => {
+        const settingCount: number = Object.keys(vscode.workspace.getConfiguration("C_Cpp")).length;
+        const iterations: number = 100;
+        let start: number = Date.now();
+        const tracker: SettingsTracker = new SettingsTracker(undefined); // Walks and inspects every setting.
+        const fullWalkTime: number = Date.now() - start;
+        start = Date.now();
+        for (let i: number = 0; i < iterations; ++i) {
+            assert.deepStrictEqual(tracker.getChangedSettings(), {});
+        }
+        const unchangedTime: number = (Date.now() - start) / iterations;
+        console.log(`    ${settingCount} C_Cpp settings: full walk ${fullWalkTime} ms; unchanged detection ${unchangedTime.toFixed(2)} ms.`);
+    });
+});
@@ -0,0 +1,38 @@
+/* --------------------------------------------------------------------------------------------
+ * Copyright (c) Microsoft Corporation. All Rights Reserved.
+ * See 'LICENSE' in the project root for license information.
+ * ------------------------------------------------------------------------------------------ */
+import * as assert from "assert";
+import * as vscode from "vscode";
+import { WorkspaceFolderTrie, WorkspaceFolderEntry } from "../../src/LanguageServer/workspaceFolderTrie";
+
+suite("Workspace folder trie", () => {
+    const folders: vscode.WorkspaceFolder[] = [];
+    for (let i: number = 0; i < 60; ++i) {
+        folders.push({ uri: vscode.Uri.file(`/work/repo/folder${i}`), name: `folder${i}`, index: i });
+    }
+    folders.push({ uri: vscode.Uri.file("/work/repo/folder1/nested"), name: "nested", index: folders.length });
+
+    function getName(trie: WorkspaceFolderTrie, fsPath: string): string | undefined {
+        const entry: WorkspaceFolderEntry | undefined = trie.getFolder(vscode.Uri.file(fsPath));
+        return entry?.folder.name;
+    }
+
+    test("URIs map to their innermost workspace folder", () => {
+        const trie: WorkspaceFolderTrie = new WorkspaceFolderTrie(folders);
+        assert.strictEqual(getName(trie, "/work/repo/folder10/src/a.cpp"), "folder10");
+        assert.strictEqual(getName(trie, "/work/repo/folder1/src/a.cpp"), "folder1");
+        assert.strictEqual(getName(trie, "/work/repo/folder1/nested/a.cpp"), "nested");
+        assert.strictEqual(getName(trie, "/work/repo/folder100/a.cpp"), undefined);
+        assert.strictEqual(getName(trie, "/work/a.cpp"), undefined);
+        assert.strictEqual(trie.getFolder(vscode.Uri.parse("untitled:Untitled-1")), undefined);
+    });
+
+    test("Resetting the folders invalidates memoized lookups", () => {
+        const trie: WorkspaceFolderTrie = new WorkspaceFolderTrie(folders);
+        assert.strictEqual(getName(trie, "/work/repo/folder1/nested/a.cpp"), "nested");
+        trie.reset(folders.slice(0, 60));
+        assert.strictEqual(getName(trie, "/work/repo/folder1/nested/a.cpp"), "folder1");
+        assert.strictEqual(trie.getFolder(vscode.Uri.file("/work/repo/folder1/a.cpp"))?.key, "file:///work/repo/folder1/");
+    });
+});